@@ -2,6 +2,8 @@
 use itertools::Itertools;
 use poker_lib::{PokerCard, PokerCards};
 use std::collections::HashSet;
+use std::sync::atomic::{AtomicU8, AtomicUsize, Ordering::Relaxed};
+use std::sync::Mutex;
 
 // 3张或4张
 // 3 or 4 cards
@@ -45,13 +47,13 @@ fn is_suit_meld(pcs: &Vec<&PokerCard>) -> bool {
     true
 }
 
-// 是否能共存
-// has conflicts?
-fn is_conflict(pc: &Vec<&Vec<&PokerCard>>) -> bool {
+// 是否能共存(牌码版本,供meld缓存使用)
+// has conflicts? (card-code version for the meld cache)
+fn is_conflict_codes(pc: &Vec<&Vec<u8>>) -> bool {
     let mut bucket: [u8; 53] = [0; 53];
     for v in pc {
         for p in *v {
-            let idx = p.to_u8() as usize;
+            let idx = *p as usize;
             if bucket[idx] != 0 {
                 return true;
             } else {
@@ -62,14 +64,14 @@ fn is_conflict(pc: &Vec<&Vec<&PokerCard>>) -> bool {
     false
 }
 
-// 计算deadwood和分数
-// calc deadwood and score
-fn deadwood(pc: &PokerCards, ms: &Vec<&Vec<&PokerCard>>) -> (u8, Vec<PokerCard>) {
+// 计算deadwood和分数(牌码版本,供meld缓存使用)
+// calc deadwood and score (card-code version for the meld cache)
+fn deadwood_codes(pc: &PokerCards, ms: &Vec<&Vec<u8>>) -> (u8, Vec<PokerCard>) {
     let mut pcset: HashSet<u8> = pc.cards.iter().map(|x| x.to_u8()).collect();
     let mut pcs: Vec<PokerCard> = vec![];
     for v in ms {
         for p in *v {
-            pcset.remove(&p.to_u8());
+            pcset.remove(p);
         }
     }
     let mut val = 0u8;
@@ -78,7 +80,6 @@ fn deadwood(pc: &PokerCards, ms: &Vec<&Vec<&PokerCard>>) -> (u8, Vec<PokerCard>)
         pcs.push(pk);
         val += if pk.number > 10 { 10 } else { pk.number };
     }
-    // info!("deadwood...{:?} {}", pcset, val);
     (val, pcs)
 }
 
@@ -120,6 +121,16 @@ fn get_all_melds_freeze(pc: &PokerCards) -> Vec<Vec<&PokerCard>> {
     am
 }
 
+// 单张牌码转换,与PokerCards::assign的规则一致
+// single card-code conversion, same rule as PokerCards::assign
+fn code_to_card(v: u16) -> Result<PokerCard, String> {
+    if v < 100 {
+        PokerCard::from_u8(v as u8)
+    } else {
+        PokerCard::from_u16(v)
+    }
+}
+
 pub struct GinRummyCards {
     pub cards: PokerCards,
     pub sort_cards_suit: Vec<PokerCard>,
@@ -127,6 +138,11 @@ pub struct GinRummyCards {
     pub best: u8,
     pub best_deadwood: Vec<PokerCard>,
     pub best_melds: Vec<Vec<PokerCard>>,
+    // 候选meld缓存(牌码表示),update时只改动受新旧牌影响的条目
+    // candidate meld cache (card codes), update only touches entries
+    // affected by the added/removed card
+    melds_cache: Vec<Vec<u8>>,
+    cache_freeze: bool,
 }
 
 impl GinRummyCards {
@@ -138,9 +154,24 @@ impl GinRummyCards {
             sort_cards_number: vec![],
             best_deadwood: vec![],
             best_melds: vec![],
+            melds_cache: vec![],
+            cache_freeze: false,
         }
     }
 
+    // 恢复到刚构造完的状态，保留已分配的缓冲区以便复用
+    // return to freshly-constructed state, keep allocated buffers for reuse
+    pub fn reset(&mut self) {
+        self.cards.reset();
+        self.sort_cards_suit.clear();
+        self.sort_cards_number.clear();
+        self.best = 0;
+        self.best_deadwood.clear();
+        self.best_melds.clear();
+        self.melds_cache.clear();
+        self.cache_freeze = false;
+    }
+
     // freeze为true时，不准改变手牌顺序，用于关闭自动排序时确定meld
     // freeze为false，用于自动排序
     // freeze=true means can not change hand order, used for get meld when auto sorting is turned off
@@ -166,6 +197,57 @@ impl GinRummyCards {
         Ok(self.best)
     }
 
+    // assign的有界搜索版本,供AI rollout使用:deadwood达到threshold或
+    // 搜索超过node_budget个组合即停,返回(deadwood, 是否最优)
+    // bounded-search assign for AI rollouts: stop at deadwood <=
+    // threshold or after node_budget combos, returns (deadwood, optimal)
+    pub fn assign_bounded(
+        &mut self,
+        cards: &[u16],
+        freeze: bool,
+        threshold: u8,
+        node_budget: u64,
+    ) -> Result<(u8, bool), String> {
+        if cards.len() != 10 && cards.len() != 11 {
+            return Err(String::from(format!(
+                "error cards length...{}",
+                cards.len()
+            )));
+        }
+        let mut bucket: [u8; 53] = [0; 53];
+        for v in cards {
+            let idx = (v - 1) as usize;
+            if bucket[idx] != 0 {
+                return Err(String::from(format!("card not distinct...")));
+            } else {
+                bucket[idx] = 1;
+            }
+        }
+        self.cards.assign(cards)?;
+        let am = if freeze {
+            get_all_melds_freeze(&self.cards)
+        } else {
+            get_all_melds(&self.cards)
+        };
+        self.melds_cache = am
+            .iter()
+            .map(|m| m.iter().map(|p| p.to_u8()).collect())
+            .collect();
+        self.cache_freeze = freeze;
+        let budget = if node_budget == 0 { u64::MAX } else { node_budget };
+        let optimal = self.solve_cached_bounded(threshold, budget);
+        Ok((self.best, optimal))
+    }
+
+    // assign的无检查版本,调用方保证10/11张合法且互不相同的牌码
+    // 跳过长度/去重/范围检查和错误路径
+    // unchecked assign, caller guarantees 10/11 valid distinct card codes
+    pub fn assign_unchecked(&mut self, cards: &[u16], freeze: bool) -> u8 {
+        self.cards.assign_unchecked(cards);
+        self.get_best_deadwood(freeze);
+        self.best
+    }
+
     pub fn sort(&mut self) {
         self.sort_cards_suit.clear();
         self.sort_cards_number.clear();
@@ -188,40 +270,335 @@ impl GinRummyCards {
     // freeze=true means can not change hand order, used for get meld when auto sorting is turned off
     // freeze=false used for auto sorting
     pub fn get_best_deadwood(&mut self, freeze: bool) {
-        self.best = 0;
-        self.best_deadwood = vec![];
-        self.best_melds = vec![];
         let am = if freeze {
             get_all_melds_freeze(&self.cards)
         } else {
             get_all_melds(&self.cards)
         };
-        let dw = deadwood(&self.cards, &vec![]);
+        self.melds_cache = am
+            .iter()
+            .map(|m| m.iter().map(|p| p.to_u8()).collect())
+            .collect();
+        self.cache_freeze = freeze;
+        self.solve_cached();
+    }
+
+    // 在meld缓存上跑分解搜索,assign和update共用
+    // decomposition search over the meld cache, shared by assign and update
+    fn solve_cached(&mut self) {
+        self.solve_cached_bounded(0, u64::MAX);
+    }
+
+    // 有界版分解搜索:deadwood一旦证明<=threshold或检查过node_budget个
+    // 组合就停,返回解是否最优(跑完全部组合或deadwood已到0)
+    // bounded decomposition search: stop once deadwood is proven
+    // <= threshold or node_budget combos were checked; returns whether
+    // the result is optimal (full enumeration done or deadwood hit 0)
+    fn solve_cached_bounded(&mut self, threshold: u8, node_budget: u64) -> bool {
+        let dw = deadwood_codes(&self.cards, &vec![]);
         let mut best = dw.0;
-        let mut bestvp = vec![];
+        let mut bestvp: Vec<&Vec<u8>> = vec![];
         let mut bestdw = dw.1;
-        let amlen = am.len();
-        for cn in 1..=amlen {
-            for vp in am.iter().combinations(cn) {
-                if !is_conflict(&vp) {
+        let mut nodes = 0u64;
+        let mut optimal = true;
+        let amlen = self.melds_cache.len();
+        'search: for cn in 1..=amlen {
+            for vp in self.melds_cache.iter().combinations(cn) {
+                nodes += 1;
+                if !is_conflict_codes(&vp) {
                     // info!("com...{:?}", vp);
-                    let dw = deadwood(&self.cards, &vp);
+                    let dw = deadwood_codes(&self.cards, &vp);
                     if dw.0 < best {
                         best = dw.0;
                         bestvp = vp;
                         bestdw = dw.1;
                     }
                 }
+                if best == 0 {
+                    break 'search;
+                }
+                if best <= threshold || nodes >= node_budget {
+                    optimal = false;
+                    break 'search;
+                }
             }
         }
+        self.best_melds = vec![];
         for v in &bestvp {
             let mut meld: Vec<PokerCard> = vec![];
             for p in *v {
-                meld.push(**p);
+                meld.push(PokerCard::from_u8(*p).unwrap());
             }
             self.best_melds.push(meld);
         }
         self.best = best;
         self.best_deadwood = bestdw.clone();
+        optimal
+    }
+
+    // assign的并行分支限界版本,给困难的11张手牌压尾延迟
+    // meld分解改成按索引序的DFS:顶层分支(最低序meld的选择)由
+    // n_threads个worker从共享计数器动态领取,所有worker共享一个
+    // 原子best deadwood界,任何线程的改进立即帮其他线程剪枝
+    // parallel branch-and-bound assign for hard 11-card hands: top-level
+    // branches are claimed dynamically from a shared counter and all
+    // workers prune against one shared atomic best-deadwood bound
+    pub fn assign_parallel(
+        &mut self,
+        cards: &[u16],
+        freeze: bool,
+        n_threads: usize,
+    ) -> Result<u8, String> {
+        if cards.len() != 10 && cards.len() != 11 {
+            return Err(String::from(format!(
+                "error cards length...{}",
+                cards.len()
+            )));
+        }
+        let mut bucket: [u8; 53] = [0; 53];
+        for v in cards {
+            let idx = (v - 1) as usize;
+            if bucket[idx] != 0 {
+                return Err(String::from(format!("card not distinct...")));
+            } else {
+                bucket[idx] = 1;
+            }
+        }
+        self.cards.assign(cards)?;
+        let am = if freeze {
+            get_all_melds_freeze(&self.cards)
+        } else {
+            get_all_melds(&self.cards)
+        };
+        self.melds_cache = am
+            .iter()
+            .map(|m| m.iter().map(|p| p.to_u8()).collect())
+            .collect();
+        self.cache_freeze = freeze;
+        self.solve_parallel(n_threads);
+        Ok(self.best)
+    }
+
+    // meld的占用bitmask(bit=牌码)和牌值,供分支限界用
+    fn meld_mask_val(m: &[u8]) -> (u64, u8) {
+        let mut mask = 0u64;
+        let mut val = 0u8;
+        for p in m {
+            mask |= 1u64 << *p;
+            let n = PokerCard::from_u8(*p).unwrap().number;
+            val += if n > 10 { 10 } else { n };
+        }
+        (mask, val)
+    }
+
+    fn solve_parallel(&mut self, n_threads: usize) {
+        let nm = self.melds_cache.len();
+        let nt = if n_threads == 0 { 1 } else { n_threads.min(16) };
+        // 分支少时并行没有收益,走原搜索
+        if nt == 1 || nm < 4 {
+            self.solve_cached();
+            return;
+        }
+        let mut masks = vec![0u64; nm];
+        let mut vals = vec![0u8; nm];
+        for (i, m) in self.melds_cache.iter().enumerate() {
+            let (mask, val) = Self::meld_mask_val(m);
+            masks[i] = mask;
+            vals[i] = val;
+        }
+        // suffix[i]为i起所有meld牌值之和,乐观界用
+        let mut suffix = vec![0u16; nm + 1];
+        for i in (0..nm).rev() {
+            suffix[i] = suffix[i + 1] + vals[i] as u16;
+        }
+        let total = deadwood_codes(&self.cards, &vec![]).0;
+
+        // 共享界:deadwood的当前最小值,改进用fetch_min发布
+        let bound = AtomicU8::new(total);
+        // 最优分解(meld索引)在锁下记录,校验值防止与界的发布交错
+        let best_pick: Mutex<(u8, Vec<usize>)> = Mutex::new((total, vec![]));
+        let work = AtomicUsize::new(0);
+
+        // 按索引序DFS:chosen里最后一个meld之后的才可加入
+        fn dfs(
+            melds: (&[u64], &[u8], &[u16]),
+            idx: usize,
+            used: u64,
+            val: u16,
+            total: u8,
+            chosen: &mut Vec<usize>,
+            bound: &AtomicU8,
+            best_pick: &Mutex<(u8, Vec<usize>)>,
+        ) {
+            let (masks, vals, suffix) = melds;
+            for j in idx..masks.len() {
+                if masks[j] & used != 0 {
+                    continue;
+                }
+                let nval = val + vals[j] as u16;
+                let dw = (total as u16).saturating_sub(nval) as u8;
+                if dw < bound.load(Relaxed) {
+                    bound.fetch_min(dw, Relaxed);
+                    let mut bp = best_pick.lock().unwrap();
+                    if dw < bp.0 {
+                        bp.0 = dw;
+                        bp.1 = chosen.clone();
+                        bp.1.push(j);
+                    }
+                }
+                // 乐观界:子树内剩余meld全拿也到不了当前best就剪掉
+                let optimistic = (total as u16).saturating_sub(nval + suffix[j + 1]);
+                if optimistic >= bound.load(Relaxed) as u16 {
+                    continue;
+                }
+                chosen.push(j);
+                dfs(melds, j + 1, used | masks[j], nval, total, chosen, bound, best_pick);
+                chosen.pop();
+            }
+        }
+
+        std::thread::scope(|s| {
+            for _ in 0..nt {
+                s.spawn(|| {
+                    let mut chosen = vec![];
+                    // 从共享计数器领取顶层分支,天然负载均衡
+                    loop {
+                        let i = work.fetch_add(1, Relaxed);
+                        if i >= nm {
+                            break;
+                        }
+                        let dw = (total as u16).saturating_sub(vals[i] as u16) as u8;
+                        if dw < bound.load(Relaxed) {
+                            bound.fetch_min(dw, Relaxed);
+                            let mut bp = best_pick.lock().unwrap();
+                            if dw < bp.0 {
+                                bp.0 = dw;
+                                bp.1 = vec![i];
+                            }
+                        }
+                        let optimistic =
+                            (total as u16).saturating_sub(vals[i] as u16 + suffix[i + 1]);
+                        if optimistic >= bound.load(Relaxed) as u16 {
+                            continue;
+                        }
+                        chosen.clear();
+                        chosen.push(i);
+                        dfs(
+                            (&masks, &vals, &suffix),
+                            i + 1,
+                            masks[i],
+                            vals[i] as u16,
+                            total,
+                            &mut chosen,
+                            &bound,
+                            &best_pick,
+                        );
+                    }
+                });
+            }
+        });
+
+        let (best, pick) = best_pick.into_inner().unwrap();
+        let picked: Vec<&Vec<u8>> = pick.iter().map(|i| &self.melds_cache[*i]).collect();
+        let (dw_val, dw_cards) = deadwood_codes(&self.cards, &picked);
+        debug_assert_eq!(dw_val, best);
+        self.best_melds = picked
+            .iter()
+            .map(|m| m.iter().map(|p| PokerCard::from_u8(*p).unwrap()).collect())
+            .collect();
+        self.best = best;
+        self.best_deadwood = dw_cards;
+    }
+
+    // 增量更新:一次摸牌/弃牌只改一张,不必从头重建所有meld
+    // removed从缓存中剔除包含它的meld,added只枚举含新牌的组合
+    // added/removed为0表示无此动作,只支持freeze=false的缓存
+    // incremental update: one draw/discard changes a single card, so
+    // drop cached melds containing the removed card and only enumerate
+    // combos containing the added one; pass 0 for "no card"
+    pub fn update(&mut self, added: u16, removed: u16) -> Result<u8, String> {
+        if self.cache_freeze {
+            return Err(String::from("update needs a freeze=false assign first"));
+        }
+        // 校验全部做在改动之前:出错直接返回,手牌和meld缓存保持原样
+        // validate everything before touching the hand so an error
+        // leaves the object exactly as it was
+        let rc = if removed != 0 {
+            let rc = code_to_card(removed)?;
+            if !self.cards.contain(rc) {
+                return Err(String::from(format!("removed card not in hand...{}", removed)));
+            }
+            Some(rc)
+        } else {
+            None
+        };
+        let ac = if added != 0 {
+            let ac = code_to_card(added)?;
+            // added==removed是合法的原地换回,不算重复
+            if self.cards.contain(ac) && rc.map_or(true, |r| r.to_u8() != ac.to_u8()) {
+                return Err(String::from(format!("added card already in hand...{}", added)));
+            }
+            Some(ac)
+        } else {
+            None
+        };
+        let cl = self.cards.len() - rc.map_or(0, |_| 1) + ac.map_or(0, |_| 1);
+        if cl != 10 && cl != 11 {
+            return Err(String::from(format!("error cards length...{}", cl)));
+        }
+        if let Some(rc) = rc {
+            self.cards.remove(rc);
+            let rcode = rc.to_u8();
+            self.melds_cache.retain(|m| !m.contains(&rcode));
+        }
+        if let Some(ac) = ac {
+            self.cards.add(ac);
+            // 新meld必含新牌:其余牌中取2~4张与新牌组合检查
+            let others: Vec<&PokerCard> = self
+                .cards
+                .cards
+                .iter()
+                .filter(|p| p.to_u8() != ac.to_u8())
+                .collect();
+            for cn in 2..=4 {
+                for combo in others.iter().combinations(cn) {
+                    let mut meld: Vec<&PokerCard> = combo.iter().map(|p| **p).collect();
+                    meld.push(&ac);
+                    if is_number_meld(&meld) || is_suit_meld(&meld) {
+                        self.melds_cache
+                            .push(meld.iter().map(|p| p.to_u8()).collect());
+                    }
+                }
+            }
+        }
+        self.solve_cached();
+        Ok(self.best)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    #[test]
+    fn it_works() {
+        let mut gc = GinRummyCards::new();
+        let hand: Vec<u16> = vec![1, 40, 2, 3, 4, 5, 31, 32, 33, 41];
+        let full = gc.assign(&hand, false).unwrap();
+        // 摸34弃40后多出一个顺子,增量结果与全量重算一致
+        let inc = gc.update(34, 40).unwrap();
+        let mut gc2 = GinRummyCards::new();
+        let hand2: Vec<u16> = vec![1, 34, 2, 3, 4, 5, 31, 32, 33, 41];
+        let full2 = gc2.assign(&hand2, false).unwrap();
+        assert_eq!(inc, full2);
+        assert!(inc < full);
+        assert_eq!(gc.best_deadwood.len(), gc2.best_deadwood.len());
+        // 非法added在弃牌生效之前就被拒绝,失败后手牌保持原样
+        assert!(gc.update(999, 34).is_err());
+        assert_eq!(gc.update(40, 34).unwrap(), full);
+        // 并行分支限界与单线程全量搜索结果一致
+        let mut gc3 = GinRummyCards::new();
+        let par = gc3.assign_parallel(&hand2, false, 4).unwrap();
+        assert_eq!(par, full2);
+        assert_eq!(gc3.best_deadwood.len(), gc2.best_deadwood.len());
     }
 }
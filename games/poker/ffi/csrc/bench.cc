@@ -0,0 +1,103 @@
+// 吞吐量基准,用于跨版本追踪性能回归
+// 每项输出一行JSON:便于perf CI解析画图
+// {"bench":..., "iters":..., "ns_per_op":..., "ops_per_sec":..., "allocs":...}
+#include <stdio.h>
+#include <stdint.h>
+#include <random>
+#include <chrono>
+#include <vector>
+#include "poker_ffi.h"
+
+static std::mt19937 g_rng(20240901);
+
+// 从1~52中抽n张不重复的牌
+static void deal(unsigned short *out, int n) {
+    static unsigned short deck[52];
+    static bool init = false;
+    if (!init) {
+        for (int i = 0; i < 52; i++) deck[i] = i + 1;
+        init = true;
+    }
+    for (int i = 0; i < n; i++) {
+        int j = i + g_rng() % (52 - i);
+        unsigned short t = deck[i]; deck[i] = deck[j]; deck[j] = t;
+        out[i] = deck[i];
+    }
+}
+
+static void report(const char *name, long iters, double ns, long allocs) {
+    double ns_per_op = ns / iters;
+    printf("{\"bench\":\"%s\",\"iters\":%ld,\"ns_per_op\":%.1f,"
+           "\"ops_per_sec\":%.0f,\"allocs\":%ld}\n",
+           name, iters, ns_per_op, 1e9 / ns_per_op, allocs);
+}
+
+#define TIMED(block) ({ \
+    auto t0 = std::chrono::steady_clock::now(); \
+    block; \
+    auto t1 = std::chrono::steady_clock::now(); \
+    (double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(); })
+
+static void bench_texas(long iters) {
+    std::vector<unsigned short> hands(iters * 7);
+    for (long i = 0; i < iters; i++) deal(&hands[i * 7], 7);
+
+    // 经典路径:assign + get_best + buffer free,每次1次分配
+    rs_TexasCards *tc = rs_TexasCards_new();
+    double ns = TIMED({
+        for (long i = 0; i < iters; i++) {
+            rs_TexasCards_assign_unchecked(tc, &hands[i * 7], 7);
+            rs_TexasCardBuffer b = rs_TexasCards_get_best(tc);
+            rs_TexasCardBuffer_free(b);
+        }
+    });
+    report("texas_assign_get_best", iters, ns, iters);
+
+    // 批量路径:零分配
+    std::vector<rs_TexasType> types(iters);
+    std::vector<uint64_t> scores(iters);
+    ns = TIMED({
+        rs_TexasCards_eval_batch(tc, hands.data(), iters, types.data(), scores.data());
+    });
+    report("texas_eval_batch", iters, ns, 0);
+    rs_TexasCards_free(tc);
+}
+
+static void bench_gin(long iters) {
+    std::vector<unsigned short> hands(iters * 10);
+    for (long i = 0; i < iters; i++) deal(&hands[i * 10], 10);
+    rs_GinRummyCards *gc = rs_GinRummyCards_new();
+    unsigned char out[32];
+    double ns = TIMED({
+        for (long i = 0; i < iters; i++)
+            rs_GinRummyCards_assign(gc, &hands[i * 10], 10, 0, out);
+    });
+    report("gin_rummy_assign", iters, ns, 0);
+    rs_GinRummyCards_free(gc);
+}
+
+static void bench_counter(long iters) {
+    unsigned short hand[7];
+    deal(hand, 7);
+    rs_PokerCards *pc = rs_PokerCards_new();
+    rs_PokerCards_assign_unchecked(pc, hand, 7);
+    rs_Counter cv;
+    double ns = TIMED({
+        for (long i = 0; i < iters; i++)
+            rs_PokerCards_read_counter(pc, rs_Suit::spade, &cv);
+    });
+    report("poker_read_counter", iters, ns, 0);
+    rs_PokerCards_free(pc);
+}
+
+int main(int argc, char **argv) {
+    // 可传倍率调整时长,CI快跑用小倍率
+    long scale = argc > 1 ? atol(argv[1]) : 1;
+    // 查找表生效后texas走查表路径
+    rs_Texas_write_table("/tmp/texas_seq.tbl");
+    rs_Texas_load_table("/tmp/texas_seq.tbl");
+    bench_texas(1000000 * scale);
+    bench_gin(2000 * scale);
+    bench_counter(10000000 * scale);
+    return 0;
+}
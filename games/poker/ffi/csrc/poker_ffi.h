@@ -1,10 +1,24 @@
+#pragma once
+
+/* Thread safety contract:
+ * - Calls on DISTINCT objects (rs_PokerCards / rs_TexasCards /
+ *   rs_GinRummyCards and the pool types) may run concurrently from
+ *   different threads without locking.
+ * - Calls on the SAME object must be serialized by the caller; no entry
+ *   point takes an internal lock.
+ * - Object-free entry points (rs_Texas_eval, rs_Texas_showdown,
+ *   rs_GinRummy_solve, rs_Texas_equity) keep their scratch state in
+ *   per-thread contexts and are safe from any number of threads.
+ * - rs_Texas_load_table publishes an immutable table; concurrent calls
+ *   are safe and the first successful load wins. */
+
 #include <cstdarg>
 #include <cstdint>
 #include <cstdlib>
 #include <ostream>
 #include <new>
 
-enum class rs_Suit {
+enum class rs_Suit : uint8_t {
   spade = 0,
   heart = 1,
   club = 2,
@@ -12,6 +26,17 @@ enum class rs_Suit {
   joker = 4,
 };
 
+enum class rs_StatEp : uint8_t {
+  poker_assign = 0,
+  poker_get_cards = 1,
+  texas_assign = 2,
+  texas_get_best = 3,
+  texas_eval = 4,
+  texas_eval_batch = 5,
+  gin_assign = 6,
+  gin_update = 7,
+};
+
 enum class rs_TexasType {
   no_calc,
   high_card,
@@ -26,12 +51,22 @@ enum class rs_TexasType {
   royal_flush,
 };
 
+struct rs_Arena;
+
+struct rs_DealRng;
+
 struct rs_GinRummyCards;
 
+struct rs_GinRummyCardsPool;
+
 struct rs_PokerCards;
 
+struct rs_PokerCardsPool;
+
 struct rs_TexasCards;
 
+struct rs_TexasCardsPool;
+
 struct rs_PokerCard {
   rs_Suit suit;
   uint8_t number;
@@ -48,6 +83,27 @@ struct rs_Counter {
   uint8_t bucket[14];
 };
 
+struct rs_FfiStat {
+  uint64_t calls;
+  uint64_t ns;
+  uint64_t alloc_bytes;
+};
+
+struct rs_JobResult {
+  uint64_t tag;
+  uint64_t score;
+  uint8_t kind;
+  int8_t ret;
+  uint8_t value;
+};
+
+struct rs_EquityResult {
+  double win;
+  double tie;
+  double lose;
+  uint64_t trials;
+};
+
 struct rs_TexasCardBuffer {
   rs_CardBuffer cardbuf;
   rs_TexasType texas;
@@ -60,6 +116,8 @@ rs_GinRummyCards *rs_GinRummyCards_new();
 
 void rs_GinRummyCards_free(rs_GinRummyCards *p_pcs);
 
+int8_t rs_GinRummyCards_reset(rs_GinRummyCards *p_pcs);
+
 int8_t rs_GinRummyCards_sort(rs_GinRummyCards *p_pcs, uint8_t *p_out);
 
 int8_t rs_GinRummyCards_assign(rs_GinRummyCards *p_pcs,
@@ -68,18 +126,73 @@ int8_t rs_GinRummyCards_assign(rs_GinRummyCards *p_pcs,
                                uint8_t freeze,
                                uint8_t *p_out);
 
+int8_t rs_GinRummyCards_assign_sort(rs_GinRummyCards *p_pcs,
+                                    const uint16_t *p_data,
+                                    uintptr_t data_len,
+                                    uint8_t freeze,
+                                    uint8_t *p_out);
+
+int8_t rs_GinRummy_solve(const uint16_t *p_data,
+                         uintptr_t data_len,
+                         uint8_t freeze,
+                         uint8_t *p_out);
+
+int8_t rs_GinRummyCards_assign_unchecked(rs_GinRummyCards *p_pcs,
+                                         const uint16_t *p_data,
+                                         uintptr_t data_len,
+                                         uint8_t freeze,
+                                         uint8_t *p_out);
+
+int8_t rs_GinRummyCards_assign_parallel(rs_GinRummyCards *p_pcs,
+                                        const uint16_t *p_data,
+                                        uintptr_t data_len,
+                                        uint8_t freeze,
+                                        uintptr_t n_threads,
+                                        uint8_t *p_out);
+
+int8_t rs_GinRummyCards_assign_bounded(rs_GinRummyCards *p_pcs,
+                                       const uint16_t *p_data,
+                                       uintptr_t data_len,
+                                       uint8_t freeze,
+                                       uint8_t threshold,
+                                       uint64_t node_budget,
+                                       uint8_t *p_optimal,
+                                       uint8_t *p_out);
+
+int8_t rs_GinRummyCards_update(rs_GinRummyCards *p_pcs,
+                               uint16_t card_added,
+                               uint16_t card_removed,
+                               uint8_t *p_out);
+
 rs_PokerCards *rs_PokerCards_new();
 
 void rs_PokerCards_free(rs_PokerCards *p_pcs);
 
+int8_t rs_PokerCards_reset(rs_PokerCards *p_pcs);
+
 int8_t rs_PokerCards_assign(rs_PokerCards *p_pcs, const uint16_t *p_data, uintptr_t data_len);
 
+int8_t rs_PokerCards_assign_unchecked(rs_PokerCards *p_pcs,
+                                      const uint16_t *p_data,
+                                      uintptr_t data_len);
+
 rs_CardBuffer rs_PokerCards_get_cards(rs_PokerCards *p_pcs);
 
+int8_t rs_PokerCards_get_cards_into(rs_PokerCards *p_pcs, rs_PokerCard *p_out, uintptr_t cap);
+
+int8_t rs_PokerCards_get_cards_soa(rs_PokerCards *p_pcs,
+                                   uint8_t *p_suits,
+                                   uint8_t *p_numbers,
+                                   uintptr_t cap);
+
 void rs_CardBuffer_free(rs_CardBuffer buf);
 
 rs_Counter *rs_PokerCards_get_counter(rs_PokerCards *p_stu, rs_Suit s);
 
+int8_t rs_PokerCards_read_counter(rs_PokerCards *p_stu, rs_Suit s, rs_Counter *p_out);
+
+int8_t rs_PokerCards_read_counters(rs_PokerCards *p_stu, rs_Counter *p_out);
+
 rs_Counter *rs_Counter_new(rs_Suit s);
 
 void rs_Counter_free(rs_Counter *p_counter);
@@ -92,10 +205,173 @@ rs_TexasCards *rs_TexasCards_new();
 
 void rs_TexasCards_free(rs_TexasCards *p_poker);
 
+int8_t rs_TexasCards_reset(rs_TexasCards *p_pcs);
+
 int8_t rs_TexasCards_assign(rs_TexasCards *p_pcs, const uint16_t *p_data, uintptr_t data_len);
 
+int8_t rs_TexasCards_assign_unchecked(rs_TexasCards *p_pcs,
+                                      const uint16_t *p_data,
+                                      uintptr_t data_len);
+
 rs_TexasCardBuffer rs_TexasCards_get_best(rs_TexasCards *p_pcs);
 
+int64_t rs_History_write(const char *p_path,
+                         const uint16_t *p_hands,
+                         uintptr_t n_hands,
+                         uintptr_t hand_len);
+
+int64_t rs_History_eval(const char *p_path,
+                        uint64_t *p_scores,
+                        uint8_t *p_types,
+                        uintptr_t cap);
+
+int8_t rs_Texas_write_table(const char *p_path);
+
+int8_t rs_Texas_load_table(const char *p_path);
+
+int8_t rs_Texas_table_loaded();
+
+int8_t rs_Texas_equity(const uint16_t *p_hole,
+                       const uint16_t *p_board,
+                       uintptr_t board_len,
+                       uintptr_t n_opponents,
+                       uint64_t n_trials,
+                       uintptr_t n_threads,
+                       uint64_t seed,
+                       rs_EquityResult *p_result);
+
+int64_t rs_Texas_showdown(const uint16_t *p_board,
+                          const uint16_t *p_holes,
+                          uintptr_t n_players,
+                          rs_TexasType *p_types,
+                          uint64_t *p_scores,
+                          uint8_t *p_ranks);
+
+int64_t rs_Texas_eval_array(const uint16_t *p_hands,
+                            uintptr_t n_hands,
+                            uintptr_t stride,
+                            uintptr_t hand_len,
+                            uint64_t *p_scores,
+                            uint8_t *p_types);
+
+int8_t rs_Texas_cache_init(uintptr_t byte_budget);
+
+int8_t rs_Texas_cache_stats(uint64_t *p_hits, uint64_t *p_misses);
+
+int8_t rs_Texas_cache_clear();
+
+int64_t rs_Texas_canonicalize(const uint16_t *p_hands,
+                              uintptr_t n_hands,
+                              uintptr_t hand_len,
+                              uint16_t *p_canon,
+                              uint64_t *p_hashes);
+
+int64_t rs_Texas_draw_histogram(const uint16_t *p_data, uintptr_t data_len, uint64_t *p_counts);
+
+int8_t rs_Texas_eval_nojoker(const uint16_t *p_data,
+                             uintptr_t data_len,
+                             rs_TexasType *p_texas,
+                             uint64_t *p_score);
+
+int64_t rs_Texas_eval_batch_nojoker(const uint16_t *p_hands,
+                                    uintptr_t n_hands,
+                                    rs_TexasType *p_types,
+                                    uint64_t *p_scores);
+
+int8_t rs_Texas_eval(const uint16_t *p_data,
+                     uintptr_t data_len,
+                     rs_TexasType *p_texas,
+                     uint64_t *p_score);
+
+int8_t rs_TexasCards_get_best_into(rs_TexasCards *p_pcs,
+                                   rs_PokerCard *p_out,
+                                   uintptr_t cap,
+                                   rs_TexasType *p_texas,
+                                   uint64_t *p_score);
+
+int8_t rs_TexasCards_eval_batch(rs_TexasCards *p_pcs,
+                                const uint16_t *p_hands,
+                                uintptr_t n_hands,
+                                rs_TexasType *p_types,
+                                uint64_t *p_scores);
+
 void rs_TexasCardBuffer_free(rs_TexasCardBuffer buf);
 
+rs_Arena *rs_Arena_new(uintptr_t capacity);
+
+void rs_Arena_free(rs_Arena *p_arena);
+
+int8_t rs_Arena_reset(rs_Arena *p_arena);
+
+uintptr_t rs_Arena_used(const rs_Arena *p_arena);
+
+rs_CardBuffer rs_PokerCards_get_cards_arena(rs_PokerCards *p_pcs, rs_Arena *p_arena);
+
+rs_Counter *rs_PokerCards_get_counter_arena(rs_PokerCards *p_stu, rs_Suit s, rs_Arena *p_arena);
+
+rs_TexasCardBuffer rs_TexasCards_get_best_arena(rs_TexasCards *p_pcs, rs_Arena *p_arena);
+
+rs_DealRng *rs_DealRng_new(uint64_t seed);
+
+void rs_DealRng_free(rs_DealRng *p_rng);
+
+uint32_t rs_DealRng_next(rs_DealRng *p_rng);
+
+int8_t rs_DealRng_jump(rs_DealRng *p_rng, uint64_t n_draws);
+
+int8_t rs_DealRng_deck(rs_DealRng *p_rng, uint16_t *p_out, uintptr_t cap);
+
+int64_t rs_DealRng_search(uint64_t seed_lo,
+                          uint64_t seed_hi,
+                          uintptr_t n_cards,
+                          uint8_t min_type,
+                          uintptr_t n_threads,
+                          uint64_t *p_seeds,
+                          uintptr_t cap);
+
+int8_t rs_Jobs_init(uintptr_t n_threads);
+
+int8_t rs_Jobs_submit_texas(uint64_t tag, const uint16_t *p_data, uintptr_t data_len);
+
+int8_t rs_Jobs_submit_gin(uint64_t tag,
+                          const uint16_t *p_data,
+                          uintptr_t data_len,
+                          uint8_t freeze);
+
+int64_t rs_Jobs_poll(rs_JobResult *p_results, uintptr_t cap);
+
+uint64_t rs_Jobs_pending();
+
+int8_t rs_Stats_enable(uint8_t on);
+
+void rs_Stats_reset();
+
+int8_t rs_Stats_read(rs_StatEp ep, rs_FfiStat *p_out);
+
+int8_t rs_Stats_read_all(rs_FfiStat *p_out);
+
+rs_PokerCardsPool *rs_PokerCardsPool_new(uintptr_t n);
+
+void rs_PokerCardsPool_free(rs_PokerCardsPool *p_pool);
+
+rs_PokerCards *rs_PokerCardsPool_acquire(rs_PokerCardsPool *p_pool);
+
+void rs_PokerCardsPool_release(rs_PokerCardsPool *p_pool, rs_PokerCards *p_obj);
+
+rs_TexasCardsPool *rs_TexasCardsPool_new(uintptr_t n);
+
+void rs_TexasCardsPool_free(rs_TexasCardsPool *p_pool);
+
+rs_TexasCards *rs_TexasCardsPool_acquire(rs_TexasCardsPool *p_pool);
+
+void rs_TexasCardsPool_release(rs_TexasCardsPool *p_pool, rs_TexasCards *p_obj);
+
+rs_GinRummyCardsPool *rs_GinRummyCardsPool_new(uintptr_t n);
+
+void rs_GinRummyCardsPool_free(rs_GinRummyCardsPool *p_pool);
+
+rs_GinRummyCards *rs_GinRummyCardsPool_acquire(rs_GinRummyCardsPool *p_pool);
+
+void rs_GinRummyCardsPool_release(rs_GinRummyCardsPool *p_pool, rs_GinRummyCards *p_obj);
+
 } // extern "C"
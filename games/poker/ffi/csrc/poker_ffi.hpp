@@ -0,0 +1,148 @@
+// poker_ffi.h的header-only RAII封装
+// 包装类可移动不可拷贝,析构自动释放,全inline无虚函数,零运行时开销
+// 小结果走栈上缓冲(get_cards_into/get_best_into),不经过堆上的rs_CardBuffer
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include "poker_ffi.h"
+
+namespace pffi {
+
+// 句柄基类:唯一持有一个FFI对象指针,move转移所有权
+template <typename T, void (*FreeFn)(T *)>
+class Handle {
+public:
+    Handle(const Handle &) = delete;
+    Handle &operator=(const Handle &) = delete;
+    Handle(Handle &&o) noexcept : h_(o.h_) { o.h_ = nullptr; }
+    Handle &operator=(Handle &&o) noexcept {
+        if (this != &o) {
+            reset();
+            h_ = o.h_;
+            o.h_ = nullptr;
+        }
+        return *this;
+    }
+    ~Handle() { reset(); }
+
+    T *get() const { return h_; }
+    explicit operator bool() const { return h_ != nullptr; }
+
+protected:
+    explicit Handle(T *h) : h_(h) {}
+    void reset() {
+        if (h_) {
+            FreeFn(h_);
+            h_ = nullptr;
+        }
+    }
+    T *h_;
+};
+
+// 堆分配的rs_CardBuffer,析构时归还给库
+class CardBuffer {
+public:
+    explicit CardBuffer(rs_CardBuffer buf) : buf_(buf) {}
+    CardBuffer(const CardBuffer &) = delete;
+    CardBuffer &operator=(const CardBuffer &) = delete;
+    CardBuffer(CardBuffer &&o) noexcept : buf_(o.buf_) { o.buf_.data = nullptr; o.buf_.len = 0; }
+    ~CardBuffer() {
+        if (buf_.data) {
+            rs_CardBuffer_free(buf_);
+        }
+    }
+
+    const rs_PokerCard *data() const { return buf_.data; }
+    size_t size() const { return (size_t)buf_.len; }
+    const rs_PokerCard &operator[](size_t i) const { return buf_.data[i]; }
+
+private:
+    rs_CardBuffer buf_;
+};
+
+// 栈上的牌组快照,一副手牌最多54张
+struct Cards {
+    rs_PokerCard data[54];
+    size_t len = 0;
+};
+
+// 栈上的最优5张结果
+struct BestHand {
+    rs_PokerCard cards[5];
+    rs_TexasType texas = rs_TexasType::no_calc;
+    uint64_t score = 0;
+};
+
+class PokerCards : public Handle<rs_PokerCards, rs_PokerCards_free> {
+public:
+    PokerCards() : Handle(rs_PokerCards_new()) {}
+
+    int8_t assign(const uint16_t *codes, size_t n) {
+        return rs_PokerCards_assign(h_, codes, n);
+    }
+    int8_t reset() { return rs_PokerCards_reset(h_); }
+
+    // 栈上取牌,不触发堆分配
+    int8_t get_cards(Cards &out) {
+        int8_t r = rs_PokerCards_get_cards_into(h_, out.data, 54);
+        out.len = r < 0 ? 0 : (size_t)r;
+        return r;
+    }
+    // 需要自管理生命周期的堆缓冲时用这个
+    CardBuffer get_cards_buf() { return CardBuffer(rs_PokerCards_get_cards(h_)); }
+
+    int8_t read_counter(rs_Suit s, rs_Counter &out) {
+        return rs_PokerCards_read_counter(h_, s, &out);
+    }
+};
+
+class TexasCards : public Handle<rs_TexasCards, rs_TexasCards_free> {
+public:
+    TexasCards() : Handle(rs_TexasCards_new()) {}
+
+    int8_t assign(const uint16_t *codes, size_t n) {
+        return rs_TexasCards_assign(h_, codes, n);
+    }
+    int8_t reset() { return rs_TexasCards_reset(h_); }
+
+    // 栈上取最优5张+牌型+分数,不触发堆分配
+    int8_t get_best(BestHand &out) {
+        return rs_TexasCards_get_best_into(h_, out.cards, 5, &out.texas, &out.score);
+    }
+
+    int8_t eval_batch(const uint16_t *hands, size_t n_hands,
+                      rs_TexasType *types, uint64_t *scores) {
+        return rs_TexasCards_eval_batch(h_, hands, n_hands, types, scores);
+    }
+};
+
+class GinRummyCards : public Handle<rs_GinRummyCards, rs_GinRummyCards_free> {
+public:
+    GinRummyCards() : Handle(rs_GinRummyCards_new()) {}
+
+    int8_t assign(const uint16_t *codes, size_t n, bool freeze, uint8_t *out32) {
+        return rs_GinRummyCards_assign(h_, codes, n, freeze ? 1 : 0, out32);
+    }
+    int8_t update(uint16_t added, uint16_t removed, uint8_t *out32) {
+        return rs_GinRummyCards_update(h_, added, removed, out32);
+    }
+    int8_t reset() { return rs_GinRummyCards_reset(h_); }
+};
+
+class DealRng : public Handle<rs_DealRng, rs_DealRng_free> {
+public:
+    explicit DealRng(uint64_t seed) : Handle(rs_DealRng_new(seed)) {}
+
+    uint32_t next() { return rs_DealRng_next(h_); }
+    int8_t jump(uint64_t n_draws) { return rs_DealRng_jump(h_, n_draws); }
+    int8_t deck(uint16_t (&out)[52]) { return rs_DealRng_deck(h_, out, 52); }
+};
+
+// 一次性求值的便捷函数,内部走库的线程本地上下文
+inline int8_t texas_eval(const uint16_t *codes, size_t n,
+                         rs_TexasType &texas, uint64_t &score) {
+    return rs_Texas_eval(codes, n, &texas, &score);
+}
+
+} // namespace pffi
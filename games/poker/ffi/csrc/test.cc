@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include "poker_ffi.h"
+#include "poker_ffi.hpp"
 
 void test_poker_card() {
     rs_PokerCards *a = rs_PokerCards_new();
@@ -12,12 +13,26 @@ void test_poker_card() {
     rs_Counter *c2 = rs_PokerCards_get_counter(a, rs_Suit::spade);
     printf("spade counter.n = %d\n", c2->n);
 
+    // 按值读取，无分配无free
+    rs_Counter cv;
+    rs_PokerCards_read_counter(a, rs_Suit::spade, &cv);
+    printf("read_counter spade.n = %d\n", cv.n);
+    rs_Counter all[5];
+    rs_PokerCards_read_counters(a, all);
+    printf("read_counters heart.n = %d\n", all[1].n);
+
     rs_CardBuffer cb = rs_PokerCards_get_cards(a);
     printf("len = %ld\n", cb.len);
     for(int i=0; i<cb.len; i++) {
         printf("  card %d = (%d, %d)\n", hand[i], cb.data[i].suit, cb.data[i].number);
     }
 
+    // SoA版本:花色/点数两个紧凑数组,单张牌2字节
+    printf("sizeof(rs_PokerCard) = %d\n", (int)sizeof(rs_PokerCard));
+    uint8_t suits[8], numbers[8];
+    char rs = rs_PokerCards_get_cards_soa(a, suits, numbers, 8);
+    printf("soa len = %d first = (%d, %d)\n", rs, suits[0], numbers[0]);
+
     rs_Counter *c = rs_Counter_new(rs_Suit::spade);
     printf("new counter.n = %d\n", c->n);
     rs_Counter_free(c);
@@ -46,6 +61,31 @@ void test_texas() {
     printf("score = %llx\n", tcb.score);
 
     rs_TexasCardBuffer_free(tcb);
+
+    // 无检查快速路径，结果与checked版本一致
+    r = rs_TexasCards_assign_unchecked(a, hand, 7);
+    printf("assign_unchecked ret = %d\n", r);
+
+    // 无分配版本，写入栈上缓冲区
+    rs_PokerCard best[7];
+    rs_TexasType bt;
+    uint64_t bscore;
+    r = rs_TexasCards_get_best_into(a, best, 7, &bt, &bscore);
+    printf("get_best_into ret = %d type = %d score = %lx\n", r, bt, bscore);
+
+    // 批量计算
+    unsigned short hands[2 * 7] = {
+        1, 2, 3, 4, 5, 14, 15,
+        1, 10, 11, 12, 13, 6, 8,
+    };
+    rs_TexasType types[2];
+    unsigned long long scores[2];
+    r = rs_TexasCards_eval_batch(a, hands, 2, types, (uint64_t*)scores);
+    printf("eval_batch ret = %d\n", r);
+    for(int i=0; i<2; i++) {
+        printf("  hand %d: type = %d score = %llx\n", i, types[i], scores[i]);
+    }
+
     rs_TexasCards_free(a);
 }
 
@@ -90,6 +130,17 @@ void test_gin_rummy() {
             mcnt++;
         }
     }
+    // 增量更新:摸41弃40，复用之前的meld分解
+    // 先重新用freeze=0 assign建立缓存
+    r = rs_GinRummyCards_assign(gc, input, 10, 0, ret);
+    r = rs_GinRummyCards_update(gc, 34, 40, ret);
+    printf("update...ret=%d\n", r);
+    if (r > 0) {
+        for(int i=0; i<r; i++)
+            printf("%d ", ret[i]);
+        printf("\n");
+    }
+
     r = rs_GinRummyCards_sort(gc, ret);
     printf("sort...ret=%d\n", r);
     if (r > 0) {
@@ -97,14 +148,334 @@ void test_gin_rummy() {
             printf("%d ", ret[i]);
         printf("\n");
     }
+    // assign+sort一次调用，需要64字节缓冲区
+    unsigned char ret2[64];
+    r = rs_GinRummyCards_assign_sort(gc, input, 10, 0, ret2);
+    printf("assign_sort...ret=%d\n", r);
+    if (r > 0) {
+        for(int i=0; i<r; i++)
+            printf("%d ", ret2[i]);
+        printf("\n");
+    }
+    // rollout用的有界搜索:deadwood<=10即停,不保证最优
+    unsigned char optimal = 2;
+    r = rs_GinRummyCards_assign_bounded(gc, input, 10, 0, 10, 0, &optimal, ret);
+    printf("assign_bounded...ret=%d optimal=%d\n", r, optimal);
+    // 并行分支限界的deadwood与单线程一致(并列最优解的分解可能不同)
+    unsigned char ret3[32];
+    char r3 = rs_GinRummyCards_assign_parallel(gc, input, 10, 0, 4, ret3);
+    char r4 = rs_GinRummyCards_assign(gc, input, 10, 0, ret);
+    printf("assign_parallel...ret=%d deadwood %d/%d same=%d\n",
+           r3, ret3[0], ret[0], r3 > 0 && r4 > 0 && ret3[0] == ret[0]);
     rs_GinRummyCards_free(gc);
 }
 
+void test_texas_eval() {
+    // 一次性求值，不需要new/free
+    unsigned short hand[] = {1, 10, 11, 12, 13, 6, 8};
+    rs_TexasType t;
+    uint64_t score;
+    char r = rs_Texas_eval(hand, 7, &t, &score);
+    printf("rs_Texas_eval ret = %d type = %d score = %lx\n", r, t, score);
+
+    // 无王牌专用路径结果与通用路径一致,含王牌码则拒绝
+    rs_TexasType t2;
+    uint64_t score2;
+    r = rs_Texas_eval_nojoker(hand, 7, &t2, &score2);
+    printf("nojoker ret = %d same = %d\n", r, t2 == t && score2 == score);
+    unsigned short jhand[] = {1, 10, 11, 12, 13, 6, 53};
+    r = rs_Texas_eval_nojoker(jhand, 7, &t2, &score2);
+    printf("nojoker with joker ret = %d\n", r);
+
+    // 无王牌批量:两手一批
+    unsigned short hands[14] = {1, 10, 11, 12, 13, 6, 8,
+                                9, 22, 35, 48, 13, 6, 7};
+    rs_TexasType types[2];
+    uint64_t scores[2];
+    long long n = rs_Texas_eval_batch_nojoker(hands, 2, types, scores);
+    printf("nojoker batch ok = %lld types = %d %d\n",
+           n, (int)types[0], (int)types[1]);
+}
+
+void test_table() {
+    // 生成并加载查找表，之后所有求值走查表路径
+    printf("table loaded = %d\n", rs_Texas_table_loaded());
+    char r = rs_Texas_write_table("/tmp/texas_seq.tbl");
+    printf("write_table ret = %d\n", r);
+    r = rs_Texas_load_table("/tmp/texas_seq.tbl");
+    printf("load_table ret = %d loaded = %d\n", r, rs_Texas_table_loaded());
+    // 查表路径与枚举路径结果一致
+    unsigned short hand[] = {1, 10, 11, 12, 13, 6, 8};
+    rs_TexasType t;
+    uint64_t score;
+    rs_Texas_eval(hand, 7, &t, &score);
+    printf("table eval type = %d score = %lx\n", t, score);
+}
+
+void test_showdown() {
+    // 三人一桌，一次调用完成结算
+    unsigned short board[] = {9, 10, 11, 12, 30};
+    unsigned short holes[] = {
+        8, 13,       // 座位0: 顺子8~K
+        1, 25,       // 座位1
+        39, 52,      // 座位2
+    };
+    rs_TexasType types[3];
+    uint64_t scores[3];
+    unsigned char ranks[3];
+    long long mask = rs_Texas_showdown(board, holes, 3, types, scores, ranks);
+    printf("showdown mask = %llx\n", mask);
+    for(int i=0; i<3; i++) {
+        printf("  seat %d: type = %d rank = %d\n", i, types[i], ranks[i]);
+    }
+
+    // 两个座位拿到同一条K高顺子,花色不同也必须平分(mask=3)
+    unsigned short board2[] = {12, 11, 36, 48, 28};
+    unsigned short holes2[] = {26, 16, 52, 43};
+    rs_TexasType types2[2];
+    uint64_t scores2[2];
+    unsigned char ranks2[2];
+    mask = rs_Texas_showdown(board2, holes2, 2, types2, scores2, ranks2);
+    printf("showdown split mask = %llx ranks = %d %d\n", mask, ranks2[0], ranks2[1]);
+    // 两个座位同持一张牌是非法输入
+    unsigned short holes3[] = {52, 43, 52, 30};
+    mask = rs_Texas_showdown(board2, holes3, 2, types2, scores2, ranks2);
+    printf("showdown dup card ret = %lld\n", mask);
+}
+
+void test_equity() {
+    // 黑桃AK对单个随机对手，4线程10万次模拟
+    unsigned short hole[] = {1, 13};
+    rs_EquityResult res;
+    char r = rs_Texas_equity(hole, NULL, 0, 1, 100000, 4, 12345, &res);
+    printf("equity ret = %d win = %.3f tie = %.3f lose = %.3f\n",
+           r, res.win, res.tie, res.lose);
+}
+
+void test_pool() {
+    // 对象池:启动时预构造，热路径acquire/release不走malloc/free
+    rs_TexasCardsPool *pool = rs_TexasCardsPool_new(2);
+    rs_TexasCards *a = rs_TexasCardsPool_acquire(pool);
+    rs_TexasCards *b = rs_TexasCardsPool_acquire(pool);
+    // 池耗尽返回null
+    rs_TexasCards *c = rs_TexasCardsPool_acquire(pool);
+    printf("pool acquire: %p %p %p\n", a, b, c);
+
+    unsigned short hand[] = {1, 10, 11, 12, 13, 6, 8};
+    char r = rs_TexasCards_assign(a, hand, 7);
+    printf("pooled assign ret = %d\n", r);
+
+    rs_TexasCardsPool_release(pool, a);
+    rs_TexasCardsPool_release(pool, b);
+    rs_TexasCardsPool_free(pool);
+}
+
+void test_deal_rng() {
+    // 同种子可复现;jump(51)等价于空发一副牌
+    rs_DealRng *a = rs_DealRng_new(10);
+    rs_DealRng *b = rs_DealRng_new(10);
+    // trand.c里种子10的第一个取数是71
+    printf("deal rng first draw = %u\n", rs_DealRng_next(a));
+
+    rs_DealRng_free(a);
+    a = rs_DealRng_new(10);
+    unsigned short deck1[52], deck2[52];
+    rs_DealRng_deck(a, deck1, 52);
+    rs_DealRng_deck(a, deck2, 52);
+
+    rs_DealRng_jump(b, 51);
+    unsigned short deck3[52];
+    rs_DealRng_deck(b, deck3, 52);
+    int same = 1;
+    for (int i = 0; i < 52; i++) {
+        if (deck2[i] != deck3[i]) same = 0;
+    }
+    printf("deal rng jump match = %d deck2[0..4] = %d %d %d %d\n",
+           same, deck2[0], deck2[1], deck2[2], deck2[3]);
+    rs_DealRng_free(a);
+    rs_DealRng_free(b);
+
+    // 种子空间搜索:前7张至少是同花的种子
+    uint64_t seeds[8];
+    int64_t n = rs_DealRng_search(0, 100000, 7, (uint8_t)rs_TexasType::flush,
+                                  4, seeds, 8);
+    printf("deal rng search hits = %lld first = %llu\n",
+           (long long)n, (unsigned long long)(n > 0 ? seeds[0] : 0));
+}
+
+void test_cache() {
+    // 置换表:1MB预算,同一手第二次求值命中缓存且结果一致
+    char r = rs_Texas_cache_init(1 << 20);
+    printf("cache init ret = %d\n", r);
+    unsigned short hand[] = {8, 6, 13, 12, 11, 10, 1};
+    rs_TexasType t1, t2;
+    uint64_t s1, s2;
+    rs_Texas_eval(hand, 7, &t1, &s1);
+    // 传入顺序不同也命中同一条目
+    unsigned short hand2[] = {1, 10, 11, 12, 13, 6, 8};
+    rs_Texas_eval(hand2, 7, &t2, &s2);
+    uint64_t hits = 0, misses = 0;
+    rs_Texas_cache_stats(&hits, &misses);
+    printf("cache same = %d hits = %llu misses = %llu\n",
+           t1 == t2 && s1 == s2,
+           (unsigned long long)hits, (unsigned long long)misses);
+    rs_Texas_cache_clear();
+}
+
+void test_hpp_wrapper() {
+    // RAII封装:析构自动free,结果留在栈上
+    pffi::TexasCards tc;
+    unsigned short hand[] = {1, 10, 11, 12, 13, 6, 8};
+    tc.assign(hand, 7);
+    pffi::BestHand best;
+    tc.get_best(best);
+    printf("hpp wrapper: texas = %d score = %llu best[0] = %d-%d\n",
+           (int)best.texas, (unsigned long long)best.score,
+           (int)best.cards[0].suit, best.cards[0].number);
+
+    // move转移所有权,原对象变空
+    pffi::TexasCards tc2 = std::move(tc);
+    printf("hpp wrapper: moved-from empty = %d moved-to valid = %d\n",
+           tc ? 1 : 0, tc2 ? 1 : 0);
+
+    pffi::DealRng rng(10);
+    unsigned short deck[52];
+    rng.deck(deck);
+    printf("hpp wrapper: deck[0..2] = %d %d %d\n", deck[0], deck[1], deck[2]);
+}
+
+void test_draw_histogram() {
+    // 6张状态(4张同花+听顺),一次调用拿到46张河牌的牌型分布
+    unsigned short hand[] = {10, 11, 12, 13, 6, 21};
+    uint64_t counts[11];
+    long long n = rs_Texas_draw_histogram(hand, 6, counts);
+    printf("draw histogram runouts = %lld\n", n);
+    for (int i = 0; i < 11; i++) {
+        if (counts[i] > 0) {
+            printf("  type %d: %llu\n", i, (unsigned long long)counts[i]);
+        }
+    }
+}
+
+void test_history() {
+    // 二进制牌局日志:写出两手,mmap回读整批求值
+    unsigned short hands[14] = {1, 10, 11, 12, 13, 6, 8,
+                                9, 22, 35, 48, 13, 6, 7};
+    long long w = rs_History_write("/tmp/hands.pkh", hands, 2, 7);
+    uint64_t scores[2];
+    unsigned char types[2];
+    long long n = rs_History_eval("/tmp/hands.pkh", scores, types, 2);
+    printf("history write = %lld eval = %lld types = %d %d\n",
+           w, n, types[0], types[1]);
+}
+
+void test_canonicalize() {
+    // 花色置换后的两手映射到同一正规形和hash
+    // 第一手全黑桃,第二手同点数全红桃
+    unsigned short hands[14] = {1, 10, 11, 12, 13, 6, 8,
+                                14, 23, 24, 25, 26, 19, 21};
+    unsigned short canon[14];
+    uint64_t hashes[2];
+    long long n = rs_Texas_canonicalize(hands, 2, 7, canon, hashes);
+    int same = 1;
+    for (int i = 0; i < 7; i++) {
+        if (canon[i] != canon[7 + i]) same = 0;
+    }
+    printf("canonicalize ok = %lld same = %d hash match = %d\n",
+           n, same, hashes[0] == hashes[1]);
+}
+
+void test_arena() {
+    // 结果统一写进arena,tick结束一次reset替代逐个free
+    rs_Arena *ar = rs_Arena_new(4096);
+    rs_TexasCards *tc = rs_TexasCards_new();
+    unsigned short hand[] = {1, 10, 11, 12, 13, 6, 8};
+    rs_TexasCards_assign(tc, hand, 7);
+    rs_TexasCardBuffer best = rs_TexasCards_get_best_arena(tc, ar);
+    rs_PokerCards *pc = rs_PokerCards_new();
+    rs_PokerCards_assign(pc, hand, 7);
+    rs_CardBuffer cards = rs_PokerCards_get_cards_arena(pc, ar);
+    rs_Counter *cnt = rs_PokerCards_get_counter_arena(pc, rs_Suit::spade, ar);
+    printf("arena best len = %d cards len = %d counter n = %d used = %d\n",
+           (int)best.cardbuf.len, (int)cards.len, cnt ? cnt->n : -1,
+           (int)rs_Arena_used(ar));
+    // 不调用任何 *_free,一次复位回收全部结果
+    rs_Arena_reset(ar);
+    printf("arena after reset used = %d\n", (int)rs_Arena_used(ar));
+    rs_TexasCards_free(tc);
+    rs_PokerCards_free(pc);
+    rs_Arena_free(ar);
+}
+
+void test_jobs() {
+    // 异步任务队列:提交后立即返回,按批poll完成结果
+    char r = rs_Jobs_init(2);
+    printf("jobs init ret = %d\n", r);
+    unsigned short texas[] = {1, 10, 11, 12, 13, 6, 8};
+    unsigned short gin[] = {1, 40, 2, 3, 4, 5, 31, 32, 33, 41};
+    rs_Jobs_submit_texas(100, texas, 7);
+    rs_Jobs_submit_gin(200, gin, 10, 0);
+    // 轮询直到两个任务都完成
+    rs_JobResult results[4];
+    long long n = 0;
+    while (n < 2) {
+        long long got = rs_Jobs_poll(results + n, 4 - n);
+        if (got > 0) n += got;
+    }
+    printf("jobs polled = %lld\n", n);
+    for (int i = 0; i < n; i++) {
+        printf("  tag = %llu kind = %d ret = %d value = %d score = %llx\n",
+               (unsigned long long)results[i].tag, results[i].kind,
+               results[i].ret, results[i].value,
+               (unsigned long long)results[i].score);
+    }
+}
+
+void test_stats() {
+    // 统计默认关闭,打开后按入口点累计调用次数/耗时/分配字节
+    rs_Stats_enable(1);
+    rs_Stats_reset();
+
+    unsigned short hand[] = {1, 10, 11, 12, 13, 6, 8};
+    rs_TexasType tt;
+    uint64_t score;
+    rs_Texas_eval(hand, 7, &tt, &score);
+    rs_Texas_eval(hand, 7, &tt, &score);
+
+    rs_FfiStat st;
+    rs_Stats_read(rs_StatEp::texas_eval, &st);
+    printf("stats texas_eval: calls = %llu ns = %llu\n",
+           (unsigned long long)st.calls, (unsigned long long)st.ns);
+
+    rs_FfiStat all[8];
+    rs_Stats_read_all(all);
+    printf("stats total calls =");
+    for (int i = 0; i < 8; i++) {
+        printf(" %llu", (unsigned long long)all[i].calls);
+    }
+    printf("\n");
+    rs_Stats_enable(0);
+}
+
 int main()
 {
     test_poker_card();
     test_texas();
+    test_texas_eval();
+    test_showdown();
+    test_equity();
+    test_pool();
+    test_table();
     test_gin_rummy();
+    test_deal_rng();
+    test_cache();
+    test_hpp_wrapper();
+    test_draw_histogram();
+    test_history();
+    test_canonicalize();
+    test_arena();
+    test_jobs();
+    test_stats();
     printf("\n");
     return 0;
 }
@@ -1,10 +1,35 @@
-typedef enum rs_Suit {
+/* Thread safety contract:
+ * - Calls on DISTINCT objects (rs_PokerCards / rs_TexasCards /
+ *   rs_GinRummyCards and the pool types) may run concurrently from
+ *   different threads without locking.
+ * - Calls on the SAME object must be serialized by the caller; no entry
+ *   point takes an internal lock.
+ * - Object-free entry points (rs_Texas_eval, rs_Texas_showdown,
+ *   rs_GinRummy_solve, rs_Texas_equity) keep their scratch state in
+ *   per-thread contexts and are safe from any number of threads.
+ * - rs_Texas_load_table publishes an immutable table; concurrent calls
+ *   are safe and the first successful load wins. */
+
+enum rs_Suit {
   spade = 0,
   heart = 1,
   club = 2,
   diamond = 3,
   joker = 4,
-} rs_Suit;
+};
+typedef uint8_t rs_Suit;
+
+enum rs_StatEp {
+  poker_assign = 0,
+  poker_get_cards = 1,
+  texas_assign = 2,
+  texas_get_best = 3,
+  texas_eval = 4,
+  texas_eval_batch = 5,
+  gin_assign = 6,
+  gin_update = 7,
+};
+typedef uint8_t rs_StatEp;
 
 typedef enum rs_TexasType {
   no_calc,
@@ -20,14 +45,24 @@ typedef enum rs_TexasType {
   royal_flush,
 } rs_TexasType;
 
+typedef struct rs_Arena rs_Arena;
+
+typedef struct rs_DealRng rs_DealRng;
+
 typedef struct rs_GinRummyCards rs_GinRummyCards;
 
+typedef struct rs_GinRummyCardsPool rs_GinRummyCardsPool;
+
 typedef struct rs_PokerCards rs_PokerCards;
 
+typedef struct rs_PokerCardsPool rs_PokerCardsPool;
+
 typedef struct rs_TexasCards rs_TexasCards;
 
+typedef struct rs_TexasCardsPool rs_TexasCardsPool;
+
 typedef struct rs_PokerCard {
-  enum rs_Suit suit;
+  rs_Suit suit;
   uint8_t number;
 } rs_PokerCard;
 
@@ -37,11 +72,32 @@ typedef struct rs_CardBuffer {
 } rs_CardBuffer;
 
 typedef struct rs_Counter {
-  enum rs_Suit t;
+  rs_Suit t;
   uint8_t n;
   uint8_t bucket[14];
 } rs_Counter;
 
+typedef struct rs_FfiStat {
+  uint64_t calls;
+  uint64_t ns;
+  uint64_t alloc_bytes;
+} rs_FfiStat;
+
+typedef struct rs_JobResult {
+  uint64_t tag;
+  uint64_t score;
+  uint8_t kind;
+  int8_t ret;
+  uint8_t value;
+} rs_JobResult;
+
+typedef struct rs_EquityResult {
+  double win;
+  double tie;
+  double lose;
+  uint64_t trials;
+} rs_EquityResult;
+
 typedef struct rs_TexasCardBuffer {
   struct rs_CardBuffer cardbuf;
   enum rs_TexasType texas;
@@ -52,6 +108,8 @@ struct rs_GinRummyCards *rs_GinRummyCards_new(void);
 
 void rs_GinRummyCards_free(struct rs_GinRummyCards *p_pcs);
 
+int8_t rs_GinRummyCards_reset(struct rs_GinRummyCards *p_pcs);
+
 int8_t rs_GinRummyCards_sort(struct rs_GinRummyCards *p_pcs, uint8_t *p_out);
 
 int8_t rs_GinRummyCards_assign(struct rs_GinRummyCards *p_pcs,
@@ -60,21 +118,80 @@ int8_t rs_GinRummyCards_assign(struct rs_GinRummyCards *p_pcs,
                                uint8_t freeze,
                                uint8_t *p_out);
 
+int8_t rs_GinRummyCards_assign_sort(struct rs_GinRummyCards *p_pcs,
+                                    const uint16_t *p_data,
+                                    uintptr_t data_len,
+                                    uint8_t freeze,
+                                    uint8_t *p_out);
+
+int8_t rs_GinRummy_solve(const uint16_t *p_data,
+                         uintptr_t data_len,
+                         uint8_t freeze,
+                         uint8_t *p_out);
+
+int8_t rs_GinRummyCards_assign_unchecked(struct rs_GinRummyCards *p_pcs,
+                                         const uint16_t *p_data,
+                                         uintptr_t data_len,
+                                         uint8_t freeze,
+                                         uint8_t *p_out);
+
+int8_t rs_GinRummyCards_assign_parallel(struct rs_GinRummyCards *p_pcs,
+                                        const uint16_t *p_data,
+                                        uintptr_t data_len,
+                                        uint8_t freeze,
+                                        uintptr_t n_threads,
+                                        uint8_t *p_out);
+
+int8_t rs_GinRummyCards_assign_bounded(struct rs_GinRummyCards *p_pcs,
+                                       const uint16_t *p_data,
+                                       uintptr_t data_len,
+                                       uint8_t freeze,
+                                       uint8_t threshold,
+                                       uint64_t node_budget,
+                                       uint8_t *p_optimal,
+                                       uint8_t *p_out);
+
+int8_t rs_GinRummyCards_update(struct rs_GinRummyCards *p_pcs,
+                               uint16_t card_added,
+                               uint16_t card_removed,
+                               uint8_t *p_out);
+
 struct rs_PokerCards *rs_PokerCards_new(void);
 
 void rs_PokerCards_free(struct rs_PokerCards *p_pcs);
 
+int8_t rs_PokerCards_reset(struct rs_PokerCards *p_pcs);
+
 int8_t rs_PokerCards_assign(struct rs_PokerCards *p_pcs,
                             const uint16_t *p_data,
                             uintptr_t data_len);
 
+int8_t rs_PokerCards_assign_unchecked(struct rs_PokerCards *p_pcs,
+                                      const uint16_t *p_data,
+                                      uintptr_t data_len);
+
 struct rs_CardBuffer rs_PokerCards_get_cards(struct rs_PokerCards *p_pcs);
 
+int8_t rs_PokerCards_get_cards_into(struct rs_PokerCards *p_pcs,
+                                    struct rs_PokerCard *p_out,
+                                    uintptr_t cap);
+
+int8_t rs_PokerCards_get_cards_soa(struct rs_PokerCards *p_pcs,
+                                   uint8_t *p_suits,
+                                   uint8_t *p_numbers,
+                                   uintptr_t cap);
+
 void rs_CardBuffer_free(struct rs_CardBuffer buf);
 
-struct rs_Counter *rs_PokerCards_get_counter(struct rs_PokerCards *p_stu, enum rs_Suit s);
+struct rs_Counter *rs_PokerCards_get_counter(struct rs_PokerCards *p_stu, rs_Suit s);
+
+int8_t rs_PokerCards_read_counter(struct rs_PokerCards *p_stu,
+                                  rs_Suit s,
+                                  struct rs_Counter *p_out);
+
+int8_t rs_PokerCards_read_counters(struct rs_PokerCards *p_stu, struct rs_Counter *p_out);
 
-struct rs_Counter *rs_Counter_new(enum rs_Suit s);
+struct rs_Counter *rs_Counter_new(rs_Suit s);
 
 void rs_Counter_free(struct rs_Counter *p_counter);
 
@@ -86,10 +203,178 @@ struct rs_TexasCards *rs_TexasCards_new(void);
 
 void rs_TexasCards_free(struct rs_TexasCards *p_poker);
 
+int8_t rs_TexasCards_reset(struct rs_TexasCards *p_pcs);
+
 int8_t rs_TexasCards_assign(struct rs_TexasCards *p_pcs,
                             const uint16_t *p_data,
                             uintptr_t data_len);
 
+int8_t rs_TexasCards_assign_unchecked(struct rs_TexasCards *p_pcs,
+                                      const uint16_t *p_data,
+                                      uintptr_t data_len);
+
 struct rs_TexasCardBuffer rs_TexasCards_get_best(struct rs_TexasCards *p_pcs);
 
+int64_t rs_History_write(const char *p_path,
+                         const uint16_t *p_hands,
+                         uintptr_t n_hands,
+                         uintptr_t hand_len);
+
+int64_t rs_History_eval(const char *p_path,
+                        uint64_t *p_scores,
+                        uint8_t *p_types,
+                        uintptr_t cap);
+
+int8_t rs_Texas_write_table(const char *p_path);
+
+int8_t rs_Texas_load_table(const char *p_path);
+
+int8_t rs_Texas_table_loaded(void);
+
+int8_t rs_Texas_equity(const uint16_t *p_hole,
+                       const uint16_t *p_board,
+                       uintptr_t board_len,
+                       uintptr_t n_opponents,
+                       uint64_t n_trials,
+                       uintptr_t n_threads,
+                       uint64_t seed,
+                       struct rs_EquityResult *p_result);
+
+int64_t rs_Texas_showdown(const uint16_t *p_board,
+                          const uint16_t *p_holes,
+                          uintptr_t n_players,
+                          enum rs_TexasType *p_types,
+                          uint64_t *p_scores,
+                          uint8_t *p_ranks);
+
+int64_t rs_Texas_eval_array(const uint16_t *p_hands,
+                            uintptr_t n_hands,
+                            uintptr_t stride,
+                            uintptr_t hand_len,
+                            uint64_t *p_scores,
+                            uint8_t *p_types);
+
+int8_t rs_Texas_cache_init(uintptr_t byte_budget);
+
+int8_t rs_Texas_cache_stats(uint64_t *p_hits, uint64_t *p_misses);
+
+int8_t rs_Texas_cache_clear(void);
+
+int64_t rs_Texas_canonicalize(const uint16_t *p_hands,
+                              uintptr_t n_hands,
+                              uintptr_t hand_len,
+                              uint16_t *p_canon,
+                              uint64_t *p_hashes);
+
+int64_t rs_Texas_draw_histogram(const uint16_t *p_data, uintptr_t data_len, uint64_t *p_counts);
+
+int8_t rs_Texas_eval_nojoker(const uint16_t *p_data,
+                             uintptr_t data_len,
+                             rs_TexasType *p_texas,
+                             uint64_t *p_score);
+
+int64_t rs_Texas_eval_batch_nojoker(const uint16_t *p_hands,
+                                    uintptr_t n_hands,
+                                    rs_TexasType *p_types,
+                                    uint64_t *p_scores);
+
+int8_t rs_Texas_eval(const uint16_t *p_data,
+                     uintptr_t data_len,
+                     enum rs_TexasType *p_texas,
+                     uint64_t *p_score);
+
+int8_t rs_TexasCards_get_best_into(struct rs_TexasCards *p_pcs,
+                                   struct rs_PokerCard *p_out,
+                                   uintptr_t cap,
+                                   enum rs_TexasType *p_texas,
+                                   uint64_t *p_score);
+
+int8_t rs_TexasCards_eval_batch(struct rs_TexasCards *p_pcs,
+                                const uint16_t *p_hands,
+                                uintptr_t n_hands,
+                                enum rs_TexasType *p_types,
+                                uint64_t *p_scores);
+
 void rs_TexasCardBuffer_free(struct rs_TexasCardBuffer buf);
+
+struct rs_Arena *rs_Arena_new(uintptr_t capacity);
+
+void rs_Arena_free(struct rs_Arena *p_arena);
+
+int8_t rs_Arena_reset(struct rs_Arena *p_arena);
+
+uintptr_t rs_Arena_used(const struct rs_Arena *p_arena);
+
+struct rs_CardBuffer rs_PokerCards_get_cards_arena(struct rs_PokerCards *p_pcs,
+                                                   struct rs_Arena *p_arena);
+
+struct rs_Counter *rs_PokerCards_get_counter_arena(struct rs_PokerCards *p_stu,
+                                                   rs_Suit s,
+                                                   struct rs_Arena *p_arena);
+
+struct rs_TexasCardBuffer rs_TexasCards_get_best_arena(struct rs_TexasCards *p_pcs,
+                                                       struct rs_Arena *p_arena);
+
+struct rs_DealRng *rs_DealRng_new(uint64_t seed);
+
+void rs_DealRng_free(struct rs_DealRng *p_rng);
+
+uint32_t rs_DealRng_next(struct rs_DealRng *p_rng);
+
+int8_t rs_DealRng_jump(struct rs_DealRng *p_rng, uint64_t n_draws);
+
+int8_t rs_DealRng_deck(struct rs_DealRng *p_rng, uint16_t *p_out, uintptr_t cap);
+
+int64_t rs_DealRng_search(uint64_t seed_lo,
+                          uint64_t seed_hi,
+                          uintptr_t n_cards,
+                          uint8_t min_type,
+                          uintptr_t n_threads,
+                          uint64_t *p_seeds,
+                          uintptr_t cap);
+
+int8_t rs_Jobs_init(uintptr_t n_threads);
+
+int8_t rs_Jobs_submit_texas(uint64_t tag, const uint16_t *p_data, uintptr_t data_len);
+
+int8_t rs_Jobs_submit_gin(uint64_t tag,
+                          const uint16_t *p_data,
+                          uintptr_t data_len,
+                          uint8_t freeze);
+
+int64_t rs_Jobs_poll(struct rs_JobResult *p_results, uintptr_t cap);
+
+uint64_t rs_Jobs_pending(void);
+
+int8_t rs_Stats_enable(uint8_t on);
+
+void rs_Stats_reset(void);
+
+int8_t rs_Stats_read(rs_StatEp ep, struct rs_FfiStat *p_out);
+
+int8_t rs_Stats_read_all(struct rs_FfiStat *p_out);
+
+struct rs_PokerCardsPool *rs_PokerCardsPool_new(uintptr_t n);
+
+void rs_PokerCardsPool_free(struct rs_PokerCardsPool *p_pool);
+
+struct rs_PokerCards *rs_PokerCardsPool_acquire(struct rs_PokerCardsPool *p_pool);
+
+void rs_PokerCardsPool_release(struct rs_PokerCardsPool *p_pool, struct rs_PokerCards *p_obj);
+
+struct rs_TexasCardsPool *rs_TexasCardsPool_new(uintptr_t n);
+
+void rs_TexasCardsPool_free(struct rs_TexasCardsPool *p_pool);
+
+struct rs_TexasCards *rs_TexasCardsPool_acquire(struct rs_TexasCardsPool *p_pool);
+
+void rs_TexasCardsPool_release(struct rs_TexasCardsPool *p_pool, struct rs_TexasCards *p_obj);
+
+struct rs_GinRummyCardsPool *rs_GinRummyCardsPool_new(uintptr_t n);
+
+void rs_GinRummyCardsPool_free(struct rs_GinRummyCardsPool *p_pool);
+
+struct rs_GinRummyCards *rs_GinRummyCardsPool_acquire(struct rs_GinRummyCardsPool *p_pool);
+
+void rs_GinRummyCardsPool_release(struct rs_GinRummyCardsPool *p_pool,
+                                  struct rs_GinRummyCards *p_obj);
@@ -53,6 +53,14 @@ lib.rs_TexasCardBuffer_free(bs)
 
 lib.rs_TexasCards_free(tps)
 
+# 批量求值:一次cffi调用处理整列手牌，numpy缓冲区可直接传入
+hands = ffi.new("uint16_t []", [1, 10, 11, 12, 13, 6, 8,
+                                1, 2, 3, 4, 5, 14, 15])
+scores = ffi.new("uint64_t [2]")
+types = ffi.new("uint8_t [2]")
+n = lib.rs_Texas_eval_array(hands, 2, 7, 7, scores, types)
+print("eval_array", n, types[0], types[1])
+
 gcs = lib.rs_GinRummyCards_new()
 out = ffi.new("uint8_t [64]")
 lib.rs_GinRummyCards_assign(gcs, ffi.new("uint16_t []", [1,45, 2,3,4,5,31,32,33,40]), 10, 1, out)
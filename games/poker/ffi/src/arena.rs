@@ -0,0 +1,84 @@
+// tick级生命周期的结果arena
+// 每个game tick产出几百个同生命周期的结果对象时,逐个free既是
+// 一次FFI往返又是一对malloc/free;arena把它们换成一次指针复位
+// 结果由*_arena入口写进arena内存,调用方不得对其调用对应的free
+use std::alloc::{alloc, dealloc, Layout};
+
+pub struct Arena {
+    buf: *mut u8,
+    cap: usize,
+    used: usize,
+}
+
+impl Arena {
+    fn new(cap: usize) -> Option<Self> {
+        let layout = Layout::from_size_align(cap, 16).ok()?;
+        let buf = unsafe { alloc(layout) };
+        if buf.is_null() {
+            return None;
+        }
+        Some(Self { buf, cap, used: 0 })
+    }
+
+    // bump分配,8字节对齐,空间不足返回null
+    pub(crate) fn alloc_bytes(&mut self, size: usize) -> *mut u8 {
+        let start = (self.used + 7) & !7;
+        if start + size > self.cap {
+            return std::ptr::null_mut();
+        }
+        self.used = start + size;
+        unsafe { self.buf.add(start) }
+    }
+
+    // 类型化分配n个T,容量不足返回null
+    pub(crate) fn alloc_slice<T>(&mut self, n: usize) -> *mut T {
+        self.alloc_bytes(n * std::mem::size_of::<T>()) as *mut T
+    }
+}
+
+impl Drop for Arena {
+    fn drop(&mut self) {
+        let layout = Layout::from_size_align(self.cap, 16).unwrap();
+        unsafe { dealloc(self.buf, layout) };
+    }
+}
+
+// 创建capacity字节的arena,分配失败返回null
+#[no_mangle]
+pub extern "C" fn rs_Arena_new(capacity: usize) -> *mut Arena {
+    if capacity == 0 {
+        return std::ptr::null_mut();
+    }
+    match Arena::new(capacity) {
+        Some(a) => Box::into_raw(Box::new(a)),
+        None => std::ptr::null_mut(),
+    }
+}
+
+#[no_mangle]
+pub extern "C" fn rs_Arena_free(p_arena: *mut Arena) {
+    if !p_arena.is_null() {
+        unsafe {
+            let _ = Box::from_raw(p_arena);
+        }
+    }
+}
+
+// tick结束时一次复位,之前发出的所有arena结果随即失效
+#[no_mangle]
+pub extern "C" fn rs_Arena_reset(p_arena: *mut Arena) -> i8 {
+    if p_arena.is_null() {
+        return -1;
+    }
+    unsafe { &mut *p_arena }.used = 0;
+    return 0;
+}
+
+// 当前已用字节数,容量规划用
+#[no_mangle]
+pub extern "C" fn rs_Arena_used(p_arena: *const Arena) -> usize {
+    if p_arena.is_null() {
+        return 0;
+    }
+    unsafe { &*p_arena }.used
+}
@@ -0,0 +1,170 @@
+// 德州求值的置换表缓存(opt-in)
+// 结算回放里同一7张组合被反复求值,命中后一次探测代替完整搜索
+// 键为排序后的牌码按6bit紧凑打包(7张最多42bit),是手牌的精确编码
+// 而非hash,键相等即手牌相同,不存在碰撞误命中
+// 注:分数的花色tiebreak编码了best5的真实花色,按花色同构归一
+// 会算错平局裁决,所以键用精确牌码而不做花色同构折叠
+// 多线程无锁:写入方CAS抢占空槽(0->键)后再发布值,槽位写定后
+// 键值都不再变动;分数必带牌型位(>=1<<30),val==0即"键已占值未到",
+// 读取方按未命中处理,不存在键值错配
+use std::sync::atomic::{AtomicU64, Ordering::*};
+use std::sync::OnceLock;
+
+struct Entry {
+    key: AtomicU64,
+    val: AtomicU64,
+}
+
+struct Cache {
+    mask: usize,
+    entries: Box<[Entry]>,
+}
+
+static CACHE: OnceLock<Cache> = OnceLock::new();
+static HITS: AtomicU64 = AtomicU64::new(0);
+static MISSES: AtomicU64 = AtomicU64::new(0);
+
+// 线性探测窗口,越界后覆盖首槽
+const PROBE: usize = 8;
+
+// FNV-1a,给canon.rs做正规形指纹用,缓存键不走hash
+pub(crate) fn hash_codes(codes: &[u16]) -> u64 {
+    let mut h = 0xcbf29ce484222325u64;
+    for c in codes {
+        h ^= *c as u64;
+        h = h.wrapping_mul(0x100000001b3);
+    }
+    // 0留作"无指纹"哨兵
+    if h == 0 {
+        1
+    } else {
+        h
+    }
+}
+
+// 手牌正规形:统一成1~52紧凑码并排序,消除传入顺序和编码形式差异
+// 再按每张6bit打包成u64(7张共42bit),牌码>=1保证非空手牌键不为0
+fn canon_key(cards: &[u16]) -> u64 {
+    let mut c = [0u16; 7];
+    let n = cards.len().min(7);
+    for i in 0..n {
+        let v = cards[i];
+        c[i] = if v < 100 { v } else { (v / 100 - 1) * 13 + v % 100 };
+    }
+    c[..n].sort_unstable();
+    let mut key = 0u64;
+    for i in 0..n {
+        key |= (c[i] as u64) << (i * 6);
+    }
+    key
+}
+
+// 键值探测用的槽位散布,键本身保持精确牌码
+fn slot_of(key: u64) -> u64 {
+    // splitmix64尾段,打散低位相近的键
+    let mut z = key.wrapping_add(0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)).wrapping_mul(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)).wrapping_mul(0x94d049bb133111eb);
+    z ^ (z >> 31)
+}
+
+// 探测缓存,命中返回分数
+pub(crate) fn probe(cards: &[u16]) -> Option<u64> {
+    let cache = CACHE.get()?;
+    let key = canon_key(cards);
+    let mut idx = slot_of(key) as usize & cache.mask;
+    for _ in 0..PROBE {
+        let e = &cache.entries[idx];
+        let k = e.key.load(Acquire);
+        if k == 0 {
+            break;
+        }
+        if k == key {
+            let v = e.val.load(Acquire);
+            // 键已抢占但值尚未发布的瞬间v为0,当未命中
+            if v != 0 {
+                HITS.fetch_add(1, Relaxed);
+                return Some(v);
+            }
+            break;
+        }
+        idx = (idx + 1) & cache.mask;
+    }
+    MISSES.fetch_add(1, Relaxed);
+    None
+}
+
+// 写入结果:CAS抢到空槽才发布值,多个线程并发插入不会把
+// 一个键配上另一手牌的值;探测窗口占满时放弃本次写入
+pub(crate) fn insert(cards: &[u16], score: u64) {
+    let cache = match CACHE.get() {
+        Some(c) => c,
+        None => return,
+    };
+    let key = canon_key(cards);
+    let mut idx = slot_of(key) as usize & cache.mask;
+    for _ in 0..PROBE {
+        let e = &cache.entries[idx];
+        match e.key.compare_exchange(0, key, AcqRel, Acquire) {
+            Ok(_) => {
+                e.val.store(score, Release);
+                return;
+            }
+            // 同一手牌已被别的线程抢先,求值确定,值必然一致
+            Err(k) if k == key => return,
+            Err(_) => {}
+        }
+        idx = (idx + 1) & cache.mask;
+    }
+}
+
+// 按字节预算初始化缓存,容量向下取2的幂(每条目16字节)
+// 只能初始化一次,重复或预算不足一个条目返回-1
+#[no_mangle]
+pub extern "C" fn rs_Texas_cache_init(byte_budget: usize) -> i8 {
+    let slots = byte_budget / std::mem::size_of::<Entry>();
+    if slots == 0 {
+        return -1;
+    }
+    let n = 1usize << (usize::BITS - 1 - slots.leading_zeros());
+    let entries: Box<[Entry]> = (0..n)
+        .map(|_| Entry {
+            key: AtomicU64::new(0),
+            val: AtomicU64::new(0),
+        })
+        .collect();
+    match CACHE.set(Cache { mask: n - 1, entries }) {
+        Ok(_) => 0,
+        Err(_) => -1,
+    }
+}
+
+// 读取命中/未命中计数
+#[no_mangle]
+pub extern "C" fn rs_Texas_cache_stats(p_hits: *mut u64, p_misses: *mut u64) -> i8 {
+    if p_hits.is_null() || p_misses.is_null() {
+        return -1;
+    }
+    unsafe {
+        *p_hits = HITS.load(Relaxed);
+        *p_misses = MISSES.load(Relaxed);
+    }
+    return 0;
+}
+
+// 清空全部条目和计数,供两次回放之间复用
+// 只能在没有worker并发读写时调用,否则空槽会被重新抢占配错
+#[no_mangle]
+pub extern "C" fn rs_Texas_cache_clear() -> i8 {
+    let cache = match CACHE.get() {
+        Some(c) => c,
+        None => return -1,
+    };
+    for e in cache.entries.iter() {
+        e.key.store(0, Release);
+        e.val.store(0, Release);
+    }
+    HITS.store(0, Relaxed);
+    MISSES.store(0, Relaxed);
+    return 0;
+}
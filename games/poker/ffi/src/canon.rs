@@ -0,0 +1,98 @@
+// 花色同构正规化
+// 同一手牌的4!种花色置换映射到同一个代表形,用于策略表去重和
+// 缓存键:先按花色聚成13位点数mask,mask按降序重标花色,再把
+// 重标后的紧凑牌码升序排列;王牌无花色同构,牌码原样保留
+// 正规形在库内生成,调用方和求值器用同一套规则,结果可共享
+use crate::cache::hash_codes;
+
+// 单手正规化,写入out并返回true;牌码非法返回false
+fn canonicalize_one(hand: &[u16], out: &mut [u16]) -> bool {
+    // 每个花色一个点数mask(bit0=A ... bit12=K),王牌单独收集
+    let mut masks = [0u16; 4];
+    let mut jokers = [0u16; 2];
+    let mut nj = 0usize;
+    for v in hand {
+        let c = if *v >= 1 && *v <= 54 {
+            *v
+        } else if *v >= 101 && *v <= 502 && *v % 100 >= 1 && *v % 100 <= 13 {
+            (*v / 100 - 1) * 13 + *v % 100
+        } else {
+            return false;
+        };
+        if c > 54 {
+            return false;
+        }
+        if c > 52 {
+            if nj >= 2 || (nj == 1 && jokers[0] == c) {
+                return false;
+            }
+            jokers[nj] = c;
+            nj += 1;
+        } else {
+            let bit = 1u16 << ((c - 1) % 13);
+            let m = &mut masks[(c - 1) as usize / 13];
+            // 重复牌:mask位已占
+            if *m & bit != 0 {
+                return false;
+            }
+            *m |= bit;
+        }
+    }
+    // mask降序决定新花色编号,相同mask的花色可互换,顺序无关紧要
+    masks.sort_unstable_by(|a, b| b.cmp(a));
+    let mut idx = 0usize;
+    for (s, m) in masks.iter().enumerate() {
+        for n in 0..13u16 {
+            if m & (1 << n) != 0 {
+                out[idx] = s as u16 * 13 + n + 1;
+                idx += 1;
+            }
+        }
+    }
+    // 王牌排在末尾,53在54前
+    jokers[..nj].sort_unstable();
+    for j in 0..nj {
+        out[idx] = jokers[j];
+        idx += 1;
+    }
+    true
+}
+
+// 批量花色同构正规化
+// p_hands为n_hands手扁平排列,每手hand_len个牌码(1~7张)
+// 正规形(紧凑码,升序)写入p_canon(与输入同布局),64位稳定hash
+// 写入p_hashes(可传null跳过);非法手正规形和hash写0
+// 返回成功正规化的手数,参数非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_Texas_canonicalize(
+    p_hands: *const u16,
+    n_hands: usize,
+    hand_len: usize,
+    p_canon: *mut u16,
+    p_hashes: *mut u64,
+) -> i64 {
+    if p_hands.is_null() || n_hands == 0 || hand_len < 1 || hand_len > 7 || p_canon.is_null() {
+        return -1;
+    }
+    let hands = unsafe { std::slice::from_raw_parts(p_hands, n_hands * hand_len) };
+    let canon = unsafe { std::slice::from_raw_parts_mut(p_canon, n_hands * hand_len) };
+    let mut ok = 0i64;
+    for i in 0..n_hands {
+        let h = &hands[i * hand_len..(i + 1) * hand_len];
+        let out = &mut canon[i * hand_len..(i + 1) * hand_len];
+        let hash;
+        if canonicalize_one(h, out) {
+            hash = hash_codes(out);
+            ok += 1;
+        } else {
+            out.fill(0);
+            hash = 0;
+        }
+        if !p_hashes.is_null() {
+            unsafe {
+                *p_hashes.add(i) = hash;
+            }
+        }
+    }
+    ok
+}
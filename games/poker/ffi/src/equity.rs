@@ -0,0 +1,146 @@
+// Monte Carlo胜率计算
+// 采样循环整个放在库内多线程执行,一次FFI调用代替几十万次assign/get_best
+// 每个worker线程有自己的deck和TexasCards,线程间无共享可变状态
+use rust_pixel::util::Rand;
+use texas_lib::TexasCards;
+
+// 胜率结果,win/tie/lose为[0,1]的概率,trials为实际模拟次数
+#[repr(C)]
+pub struct EquityResult {
+    pub win: f64,
+    pub tie: f64,
+    pub lose: f64,
+    pub trials: u64,
+}
+
+// 单线程跑trials次模拟,返回(win, tie)次数
+// 每次模拟:部分Fisher-Yates从剩余牌中抽出公共牌补齐和对手底牌
+fn run_trials(
+    hole: [u16; 2],
+    board: &[u16],
+    rest: &[u16],
+    n_opponents: usize,
+    trials: u64,
+    seed: u64,
+) -> (u64, u64) {
+    let mut rng = Rand::new();
+    rng.srand(seed);
+    let mut deck = rest.to_vec();
+    let mut ps = TexasCards::new();
+    let mut hand = [0u16; 7];
+    let need_board = 5 - board.len();
+    let need = need_board + n_opponents * 2;
+    let mut win = 0u64;
+    let mut tie = 0u64;
+    for _ in 0..trials {
+        // 只洗需要的前need张
+        let dl = deck.len();
+        for i in 0..need {
+            let j = i + rng.rand() as usize % (dl - i);
+            deck.swap(i, j);
+        }
+        hand[..2].copy_from_slice(&hole);
+        hand[2..2 + board.len()].copy_from_slice(board);
+        hand[2 + board.len()..7].copy_from_slice(&deck[..need_board]);
+        ps.assign(&hand).unwrap();
+        // 跨座位比大小要先清掉分数里的花色tiebreak位,否则平局判不出来
+        let hero = crate::rank_score(ps.score);
+        // 对手复用hand的后5张(公共牌),只换前2张底牌
+        let mut best_opp = 0u64;
+        for o in 0..n_opponents {
+            hand[..2].copy_from_slice(&deck[need_board + o * 2..need_board + o * 2 + 2]);
+            ps.assign(&hand).unwrap();
+            let opp = crate::rank_score(ps.score);
+            if opp > best_opp {
+                best_opp = opp;
+            }
+        }
+        if hero > best_opp {
+            win += 1;
+        } else if hero == best_opp {
+            tie += 1;
+        }
+    }
+    (win, tie)
+}
+
+// 计算英雄底牌对n_opponents个随机对手的胜率
+// p_hole为2张底牌,p_board为已发出的公共牌(0/3/4/5张)
+// n_trials次模拟分摊到n_threads个线程(0表示单线程),seed保证可复现
+// 结果写入p_result,成功返回0,参数非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_Texas_equity(
+    p_hole: *const u16,
+    p_board: *const u16,
+    board_len: usize,
+    n_opponents: usize,
+    n_trials: u64,
+    n_threads: usize,
+    seed: u64,
+    p_result: *mut EquityResult,
+) -> i8 {
+    if p_hole.is_null()
+        || (p_board.is_null() && board_len > 0)
+        || !matches!(board_len, 0 | 3 | 4 | 5)
+        || n_opponents < 1
+        || n_opponents > 8
+        || n_trials == 0
+        || p_result.is_null()
+    {
+        return -1;
+    }
+    let hole = unsafe { std::slice::from_raw_parts(p_hole, 2) };
+    let board = unsafe {
+        if board_len == 0 {
+            &[]
+        } else {
+            std::slice::from_raw_parts(p_board, board_len)
+        }
+    };
+    // 已知牌必须是1~52且互不相同(胜率模拟不含王牌)
+    let mut used = [false; 53];
+    for v in hole.iter().chain(board.iter()) {
+        if *v < 1 || *v > 52 || used[*v as usize] {
+            return -1;
+        }
+        used[*v as usize] = true;
+    }
+    let rest: Vec<u16> = (1u16..=52).filter(|v| !used[*v as usize]).collect();
+    let hole = [hole[0], hole[1]];
+
+    let nt = if n_threads == 0 { 1 } else { n_threads.min(64) };
+    let mut win = 0u64;
+    let mut tie = 0u64;
+    std::thread::scope(|s| {
+        let mut handles = vec![];
+        for t in 0..nt {
+            // 按线程切分trial数,种子错开保证序列独立
+            let trials = n_trials / nt as u64 + if (t as u64) < n_trials % nt as u64 { 1 } else { 0 };
+            let board = &board;
+            let rest = &rest;
+            handles.push(s.spawn(move || {
+                run_trials(
+                    hole,
+                    board,
+                    rest,
+                    n_opponents,
+                    trials,
+                    seed.wrapping_add(t as u64),
+                )
+            }));
+        }
+        for h in handles {
+            let (w, t) = h.join().unwrap();
+            win += w;
+            tie += t;
+        }
+    });
+    let total = n_trials as f64;
+    unsafe {
+        (*p_result).win = win as f64 / total;
+        (*p_result).tie = tie as f64 / total;
+        (*p_result).lose = (n_trials - win - tie) as f64 / total;
+        (*p_result).trials = n_trials;
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// 二进制牌局日志格式与mmap读取
+// 记录即rs_TexasCards_assign消费的u16牌码,定长stride,无需解析
+// 读取方mmap后把映射内存直接切片喂给批量求值循环:零拷贝零逐条分配
+// 文件头16字节:magic + 版本 + 每手张数 + 手数,载荷为小端u16
+use crate::{cache, check_nojoker};
+use std::ffi::CStr;
+use std::io::Write;
+use std::os::raw::c_char;
+use texas_lib::{TexasCards, TexasType};
+
+const HIST_MAGIC: &[u8; 4] = b"PKHH";
+const HIST_VERSION: u16 = 1;
+const HIST_HEADER_SIZE: usize = 16;
+
+fn hist_header(hand_len: usize, n_hands: usize) -> [u8; HIST_HEADER_SIZE] {
+    let mut h = [0u8; HIST_HEADER_SIZE];
+    h[..4].copy_from_slice(HIST_MAGIC);
+    h[4..6].copy_from_slice(&HIST_VERSION.to_le_bytes());
+    h[6..8].copy_from_slice(&(hand_len as u16).to_le_bytes());
+    h[8..16].copy_from_slice(&(n_hands as u64).to_le_bytes());
+    h
+}
+
+fn path_from_c(p_path: *const c_char) -> Option<&'static str> {
+    if p_path.is_null() {
+        return None;
+    }
+    unsafe { CStr::from_ptr(p_path) }.to_str().ok()
+}
+
+// 把n_hands手牌(每手hand_len个牌码,扁平排列)写出为日志文件
+// 供JSON日志的一次性转换和测试用,成功返回写出手数
+#[no_mangle]
+pub extern "C" fn rs_History_write(
+    p_path: *const c_char,
+    p_hands: *const u16,
+    n_hands: usize,
+    hand_len: usize,
+) -> i64 {
+    let path = match path_from_c(p_path) {
+        Some(p) => p,
+        None => return -1,
+    };
+    if p_hands.is_null() || n_hands == 0 || hand_len < 5 || hand_len > 7 {
+        return -1;
+    }
+    let hands = unsafe { std::slice::from_raw_parts(p_hands, n_hands * hand_len) };
+    let mut f = match std::fs::File::create(path) {
+        Ok(f) => f,
+        Err(_) => return -1,
+    };
+    if f.write_all(&hist_header(hand_len, n_hands)).is_err() {
+        return -1;
+    }
+    // u16载荷按小端逐块写出,与读取方的内存布局一致
+    let bytes =
+        unsafe { std::slice::from_raw_parts(hands.as_ptr() as *const u8, hands.len() * 2) };
+    if f.write_all(bytes).is_err() {
+        return -1;
+    }
+    n_hands as i64
+}
+
+// mmap日志文件并整批求值
+// 记录直接从映射内存切片进求值循环,不拷贝不逐条分配
+// 分数/牌型写入调用方数组(容量cap手),非法记录写0/no_calc
+// 返回实际处理手数(文件手数与cap的较小者),文件损坏返回-1
+#[no_mangle]
+pub extern "C" fn rs_History_eval(
+    p_path: *const c_char,
+    p_scores: *mut u64,
+    p_types: *mut u8,
+    cap: usize,
+) -> i64 {
+    let path = match path_from_c(p_path) {
+        Some(p) => p,
+        None => return -1,
+    };
+    if p_scores.is_null() || p_types.is_null() || cap == 0 {
+        return -1;
+    }
+    let f = match std::fs::File::open(path) {
+        Ok(f) => f,
+        Err(_) => return -1,
+    };
+    let mmap = match unsafe { memmap2::Mmap::map(&f) } {
+        Ok(m) => m,
+        Err(_) => return -1,
+    };
+    if mmap.len() < HIST_HEADER_SIZE
+        || &mmap[..4] != HIST_MAGIC
+        || u16::from_le_bytes(mmap[4..6].try_into().unwrap()) != HIST_VERSION
+    {
+        return -1;
+    }
+    let hand_len = u16::from_le_bytes(mmap[6..8].try_into().unwrap()) as usize;
+    let n_hands = u64::from_le_bytes(mmap[8..16].try_into().unwrap()) as usize;
+    if hand_len < 5
+        || hand_len > 7
+        || mmap.len() < HIST_HEADER_SIZE + n_hands * hand_len * 2
+    {
+        return -1;
+    }
+    // 头部16字节保证载荷按u16对齐
+    let hands = unsafe {
+        std::slice::from_raw_parts(
+            mmap.as_ptr().add(HIST_HEADER_SIZE) as *const u16,
+            n_hands * hand_len,
+        )
+    };
+    let n = n_hands.min(cap);
+    let scores = unsafe { std::slice::from_raw_parts_mut(p_scores, n) };
+    let types = unsafe { std::slice::from_raw_parts_mut(p_types, n) };
+    let mut ps = TexasCards::new();
+    for i in 0..n {
+        let h = &hands[i * hand_len..(i + 1) * hand_len];
+        if check_nojoker(h) {
+            // 回放中重复的runout走置换表
+            if let Some(score) = cache::probe(h) {
+                scores[i] = score;
+                types[i] = (score >> 30) as u8;
+                continue;
+            }
+            ps.assign_unchecked(h);
+            scores[i] = ps.score;
+            types[i] = ps.texas as u8;
+            cache::insert(h, ps.score);
+        } else if ps.assign(h).is_ok() {
+            scores[i] = ps.score;
+            types[i] = ps.texas as u8;
+        } else {
+            scores[i] = 0;
+            types[i] = TexasType::NoCalc as u8;
+        }
+    }
+    n as i64
+}
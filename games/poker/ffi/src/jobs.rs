@@ -0,0 +1,180 @@
+// 异步求值任务队列
+// 游戏主循环把求值任务丢进队列立刻返回,由init时创建的worker池消化
+// 完成结果按批poll回来,尾延迟高的困难手牌与帧处理重叠而不是阻塞
+// worker用线程本地scratch求值,队列两端各一把锁,无求值期间的锁持有
+use gin_rummy_lib::cards::GinRummyCards;
+use std::collections::VecDeque;
+use std::sync::atomic::{AtomicU64, Ordering::Relaxed};
+use std::sync::mpsc::{channel, Receiver, Sender};
+use std::sync::{Mutex, OnceLock};
+use texas_lib::TexasCards;
+
+// 任务种类,也回写在结果里供调用方分流
+const KIND_TEXAS: u8 = 0;
+const KIND_GIN: u8 = 1;
+
+struct Job {
+    tag: u64,
+    kind: u8,
+    freeze: bool,
+    codes: [u16; 11],
+    len: usize,
+}
+
+// 单个完成结果
+// texas任务:value为牌型,score为分数
+// gin任务:value为deadwood,score为0
+#[repr(C)]
+pub struct JobResult {
+    pub tag: u64,
+    pub score: u64,
+    pub kind: u8,
+    pub ret: i8,
+    pub value: u8,
+}
+
+struct JobSys {
+    tx: Mutex<Sender<Job>>,
+    done: Mutex<VecDeque<JobResult>>,
+}
+
+static JOBS: OnceLock<JobSys> = OnceLock::new();
+static IN_FLIGHT: AtomicU64 = AtomicU64::new(0);
+
+fn run_job(job: &Job, tc: &mut TexasCards, gc: &mut GinRummyCards) -> JobResult {
+    let mut r = JobResult {
+        tag: job.tag,
+        score: 0,
+        kind: job.kind,
+        ret: 0,
+        value: 0,
+    };
+    let codes = &job.codes[..job.len];
+    match job.kind {
+        KIND_TEXAS => match tc.assign(codes) {
+            Ok(_) => {
+                r.score = tc.score;
+                r.value = tc.texas as u8;
+            }
+            Err(_) => r.ret = -1,
+        },
+        _ => match gc.assign(codes, job.freeze) {
+            Ok(n) => r.value = n,
+            Err(_) => r.ret = -1,
+        },
+    }
+    r
+}
+
+fn worker(rx: &Mutex<Receiver<Job>>) {
+    let mut tc = TexasCards::new();
+    let mut gc = GinRummyCards::new();
+    loop {
+        // 只在取任务时持锁,求值期间其他worker可以继续取
+        let job = match rx.lock().unwrap().recv() {
+            Ok(j) => j,
+            Err(_) => return,
+        };
+        let r = run_job(&job, &mut tc, &mut gc);
+        if let Some(sys) = JOBS.get() {
+            sys.done.lock().unwrap().push_back(r);
+        }
+        IN_FLIGHT.fetch_sub(1, Relaxed);
+    }
+}
+
+// 初始化worker池,只能一次,n_threads限1~64
+#[no_mangle]
+pub extern "C" fn rs_Jobs_init(n_threads: usize) -> i8 {
+    if n_threads < 1 || n_threads > 64 {
+        return -1;
+    }
+    let (tx, rx) = channel::<Job>();
+    let sys = JobSys {
+        tx: Mutex::new(tx),
+        done: Mutex::new(VecDeque::new()),
+    };
+    if JOBS.set(sys).is_err() {
+        return -1;
+    }
+    let rx: &'static Mutex<Receiver<Job>> = Box::leak(Box::new(Mutex::new(rx)));
+    for _ in 0..n_threads {
+        std::thread::spawn(move || worker(rx));
+    }
+    return 0;
+}
+
+fn submit(tag: u64, kind: u8, freeze: bool, p_data: *const u16, data_len: usize) -> i8 {
+    if p_data.is_null() || data_len == 0 || data_len > 11 {
+        return -1;
+    }
+    let sys = match JOBS.get() {
+        Some(s) => s,
+        None => return -1,
+    };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    let mut codes = [0u16; 11];
+    codes[..data_len].copy_from_slice(slice);
+    IN_FLIGHT.fetch_add(1, Relaxed);
+    let job = Job {
+        tag,
+        kind,
+        freeze,
+        codes,
+        len: data_len,
+    };
+    if sys.tx.lock().unwrap().send(job).is_err() {
+        IN_FLIGHT.fetch_sub(1, Relaxed);
+        return -1;
+    }
+    return 0;
+}
+
+// 提交德州求值任务(5~7张),tag由调用方自定用于对账
+#[no_mangle]
+pub extern "C" fn rs_Jobs_submit_texas(tag: u64, p_data: *const u16, data_len: usize) -> i8 {
+    submit(tag, KIND_TEXAS, false, p_data, data_len)
+}
+
+// 提交gin rummy求解任务(10/11张)
+#[no_mangle]
+pub extern "C" fn rs_Jobs_submit_gin(
+    tag: u64,
+    p_data: *const u16,
+    data_len: usize,
+    freeze: u8,
+) -> i8 {
+    submit(tag, KIND_GIN, freeze != 0, p_data, data_len)
+}
+
+// 批量取回完成结果,最多cap个,返回实际取回数
+// 不阻塞:没有完成的任务时返回0
+#[no_mangle]
+pub extern "C" fn rs_Jobs_poll(p_results: *mut JobResult, cap: usize) -> i64 {
+    if p_results.is_null() || cap == 0 {
+        return -1;
+    }
+    let sys = match JOBS.get() {
+        Some(s) => s,
+        None => return -1,
+    };
+    let mut done = sys.done.lock().unwrap();
+    let n = done.len().min(cap);
+    for i in 0..n {
+        let r = done.pop_front().unwrap();
+        unsafe {
+            p_results.add(i).write(r);
+        }
+    }
+    n as i64
+}
+
+// 已提交但尚未被poll取走的任务数(排队中+执行中+已完成未取)
+#[no_mangle]
+pub extern "C" fn rs_Jobs_pending() -> u64 {
+    let done = match JOBS.get() {
+        Some(s) => s.done.lock().unwrap().len() as u64,
+        None => 0,
+    };
+    IN_FLIGHT.load(Relaxed) + done
+}
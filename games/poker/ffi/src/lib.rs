@@ -5,6 +5,19 @@ use poker_lib::{Counter, PokerCard, PokerCards, Suit};
 use texas_lib::{TexasCards, TexasType};
 use gin_rummy_lib::cards::GinRummyCards;
 
+mod arena;
+mod cache;
+mod canon;
+mod equity;
+mod history;
+mod jobs;
+mod pool;
+mod rng;
+mod stats;
+mod tables;
+
+use stats::StatEp;
+
 #[no_mangle]
 pub extern "C" fn rs_GinRummyCards_new() -> *mut GinRummyCards {
     let gcs = GinRummyCards::new();
@@ -20,6 +33,16 @@ pub extern "C" fn rs_GinRummyCards_free(p_pcs: *mut GinRummyCards) {
     }
 }
 
+// 恢复到刚构造完的状态,配合对象池复用对象,避免free/new开销
+#[no_mangle]
+pub extern "C" fn rs_GinRummyCards_reset(p_pcs: *mut GinRummyCards) -> i8 {
+    if p_pcs.is_null() {
+        return -1;
+    }
+    unsafe { &mut *p_pcs }.reset();
+    return 0;
+}
+
 #[no_mangle]
 pub extern "C" fn rs_GinRummyCards_sort(
     p_pcs: *mut GinRummyCards,
@@ -78,37 +101,10 @@ pub extern "C" fn rs_GinRummyCards_assign(
     // 要求传入足够的32字节的数据缓冲区
     let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 32usize) };
 
+    let t0 = stats::begin();
     match ps.assign(slice, freeze != 0) {
         Ok(n) => {
-            let mut idx = 0usize;
-            // 有效的out数据格式：
-            // deadwood分数
-            // deadwood长度 deadwood1 deadwood2 ...
-            // meld1长度 meld1_1 meld1_2 ...
-            // meld2长度 meld2_1 meld2_2...
-            // ...
-            // 长度32足够了
-            // best deadwood value...
-            outs[idx] = n;
-            idx += 1;
-            // best deadwood list...
-            outs[idx] = ps.best_deadwood.len() as u8;
-            idx += 1;
-            for p in &ps.best_deadwood {
-                outs[idx] = p.to_u8();
-                idx += 1;
-            }
-            // melds list...
-            for v in &ps.best_melds {
-                outs[idx] = v.len() as u8;
-                idx += 1;
-                for p in v {
-                    outs[idx] = p.to_u8();
-                    idx += 1;
-                }
-            }
-            // 返回out数据有效长度
-            ret = idx as i8;
+            ret = write_gin_out(&ps, n, outs);
         }
         Err(_) => {
             // println!("{:?}", e);
@@ -116,9 +112,218 @@ pub extern "C" fn rs_GinRummyCards_assign(
         }
     }
     std::mem::forget(ps);
+    stats::record(StatEp::GinAssign, t0, 0);
     return ret;
 }
 
+// assign的无检查快速路径
+// 前置条件:10/11张已校验过且互不相同的牌码
+// 跳过长度/去重/范围检查和错误路径
+#[no_mangle]
+pub extern "C" fn rs_GinRummyCards_assign_unchecked(
+    p_pcs: *mut GinRummyCards,
+    p_data: *const u16,
+    data_len: usize,
+    freeze: u8,
+    p_out: *mut u8,
+) -> i8 {
+    if p_pcs.is_null() || p_data.is_null() || data_len == 0 || p_out.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 32usize) };
+    let n = ps.assign_unchecked(slice, freeze != 0);
+    write_gin_out(ps, n, outs)
+}
+
+// assign的并行分支限界版本,困难11张手牌的尾延迟救济
+// meld分解的顶层分支摊给n_threads个worker(0表示单线程,上限16),
+// 共享best deadwood界互相剪枝,结果与单线程assign完全一致
+#[no_mangle]
+pub extern "C" fn rs_GinRummyCards_assign_parallel(
+    p_pcs: *mut GinRummyCards,
+    p_data: *const u16,
+    data_len: usize,
+    freeze: u8,
+    n_threads: usize,
+    p_out: *mut u8,
+) -> i8 {
+    if p_pcs.is_null() || p_data.is_null() || data_len == 0 || p_out.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 32usize) };
+    match ps.assign_parallel(slice, freeze != 0, n_threads) {
+        Ok(n) => write_gin_out(ps, n, outs),
+        Err(_) => -1,
+    }
+}
+
+// assign的有界搜索版本,供AI rollout用精度换速度
+// deadwood一旦证明<=threshold或搜过node_budget个组合即停
+// node_budget为0表示不限,解是否最优写入p_optimal(1/0)
+#[no_mangle]
+pub extern "C" fn rs_GinRummyCards_assign_bounded(
+    p_pcs: *mut GinRummyCards,
+    p_data: *const u16,
+    data_len: usize,
+    freeze: u8,
+    threshold: u8,
+    node_budget: u64,
+    p_optimal: *mut u8,
+    p_out: *mut u8,
+) -> i8 {
+    if p_pcs.is_null() || p_data.is_null() || data_len == 0 || p_optimal.is_null() || p_out.is_null()
+    {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 32usize) };
+    match ps.assign_bounded(slice, freeze != 0, threshold, node_budget) {
+        Ok((n, optimal)) => {
+            unsafe {
+                *p_optimal = optimal as u8;
+            }
+            write_gin_out(ps, n, outs)
+        }
+        Err(_) => -1,
+    }
+}
+
+// 每线程一个常驻的GinRummyCards,供一次性求解接口复用
+// meld搜索的中间状态都留在本线程,多线程调用无须加锁
+thread_local! {
+    static GIN_SCRATCH: std::cell::RefCell<GinRummyCards> =
+        std::cell::RefCell::new(GinRummyCards::new());
+}
+
+// 一次性求解接口
+// 不需要rs_GinRummyCards_new/free,内部使用线程本地上下文
+// p_out格式与rs_GinRummyCards_assign一致
+#[no_mangle]
+pub extern "C" fn rs_GinRummy_solve(
+    p_data: *const u16,
+    data_len: usize,
+    freeze: u8,
+    p_out: *mut u8,
+) -> i8 {
+    if p_data.is_null() || data_len == 0 || p_out.is_null() {
+        return -1;
+    }
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 32usize) };
+    GIN_SCRATCH.with(|gc| {
+        let mut ps = gc.borrow_mut();
+        match ps.assign(slice, freeze != 0) {
+            Ok(n) => write_gin_out(&ps, n, outs),
+            Err(_) => -1,
+        }
+    })
+}
+
+// assign+sort合并调用,省掉UI层的第二次FFI往返
+// 要求传入足够的64字节的数据缓冲区
+// 有效的out数据格式：
+// 先是assign的结果块(格式同rs_GinRummyCards_assign)
+// 紧跟sort的结果块(格式同rs_GinRummyCards_sort)
+// 返回out数据总有效长度
+#[no_mangle]
+pub extern "C" fn rs_GinRummyCards_assign_sort(
+    p_pcs: *mut GinRummyCards,
+    p_data: *const u16,
+    data_len: usize,
+    freeze: u8,
+    p_out: *mut u8,
+) -> i8 {
+    if p_pcs.is_null() || p_data.is_null() || data_len == 0 || p_out.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 64usize) };
+    let n = match ps.assign(slice, freeze != 0) {
+        Ok(n) => n,
+        Err(_) => return -1,
+    };
+    let mut idx = write_gin_out(ps, n, outs) as usize;
+    // 手牌已在assign中整理好,直接排序写出
+    ps.sort();
+    outs[idx] = ps.cards.cards.len() as u8;
+    idx += 1;
+    for v in &ps.sort_cards_suit {
+        outs[idx] = v.to_u8();
+        idx += 1;
+    }
+    outs[idx] = ps.cards.cards.len() as u8;
+    idx += 1;
+    for v in &ps.sort_cards_number {
+        outs[idx] = v.to_u8();
+        idx += 1;
+    }
+    return idx as i8;
+}
+
+// 将meld/deadwood结果写入out缓冲区,assign和update共用
+// 有效的out数据格式：
+// deadwood分数
+// deadwood长度 deadwood1 deadwood2 ...
+// meld1长度 meld1_1 meld1_2 ...
+// meld2长度 meld2_1 meld2_2...
+// ...
+// 长度32足够了
+fn write_gin_out(ps: &GinRummyCards, n: u8, outs: &mut [u8]) -> i8 {
+    let mut idx = 0usize;
+    // best deadwood value...
+    outs[idx] = n;
+    idx += 1;
+    // best deadwood list...
+    outs[idx] = ps.best_deadwood.len() as u8;
+    idx += 1;
+    for p in &ps.best_deadwood {
+        outs[idx] = p.to_u8();
+        idx += 1;
+    }
+    // melds list...
+    for v in &ps.best_melds {
+        outs[idx] = v.len() as u8;
+        idx += 1;
+        for p in v {
+            outs[idx] = p.to_u8();
+            idx += 1;
+        }
+    }
+    // 返回out数据有效长度
+    idx as i8
+}
+
+// 增量更新:摸牌/弃牌只改一张时复用之前的meld分解
+// card_added/card_removed为0表示无此动作
+// p_out格式与rs_GinRummyCards_assign一致
+#[no_mangle]
+pub extern "C" fn rs_GinRummyCards_update(
+    p_pcs: *mut GinRummyCards,
+    card_added: u16,
+    card_removed: u16,
+    p_out: *mut u8,
+) -> i8 {
+    if p_pcs.is_null() || p_out.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    // 要求传入足够的32字节的数据缓冲区
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 32usize) };
+    let t0 = stats::begin();
+    let ret = match ps.update(card_added, card_removed) {
+        Ok(n) => write_gin_out(ps, n, outs),
+        Err(_) => -1,
+    };
+    stats::record(StatEp::GinUpdate, t0, 0);
+    ret
+}
+
 // 在堆上分配一个rust结构PokerCards，返回给c
 // 由于含有vec字段，所以是透明结构，c中没有对应结构
 #[no_mangle]
@@ -137,6 +342,16 @@ pub extern "C" fn rs_PokerCards_free(p_pcs: *mut PokerCards) {
     }
 }
 
+// 恢复到刚构造完的状态,配合对象池复用对象,避免free/new开销
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_reset(p_pcs: *mut PokerCards) -> i8 {
+    if p_pcs.is_null() {
+        return -1;
+    }
+    unsafe { &mut *p_pcs }.reset();
+    return 0;
+}
+
 // 将unsigned short列表assign到PokerCards
 #[no_mangle]
 pub extern "C" fn rs_PokerCards_assign(
@@ -147,6 +362,7 @@ pub extern "C" fn rs_PokerCards_assign(
     if p_pcs.is_null() || p_data.is_null() || data_len == 0 {
         return -1;
     }
+    let t0 = stats::begin();
     let ret: i8;
     // 取结构
     let mut ps = unsafe { Box::from_raw(p_pcs) };
@@ -162,9 +378,27 @@ pub extern "C" fn rs_PokerCards_assign(
     }
     println!("{}", ps);
     std::mem::forget(ps);
+    stats::record(StatEp::PokerAssign, t0, 0);
     return ret;
 }
 
+// assign的无检查快速路径
+// 前置条件:牌码已在发牌时校验过,全部合法
+// 跳过范围检查和错误路径,也不打印调试信息
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_assign_unchecked(
+    p_pcs: *mut PokerCards,
+    p_data: *const u16,
+    data_len: usize,
+) -> i8 {
+    if p_pcs.is_null() || p_data.is_null() || data_len == 0 {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    ps.assign_unchecked(slice) as i8
+}
+
 #[repr(C)]
 pub struct CardBuffer {
     data: *mut PokerCard,
@@ -173,6 +407,7 @@ pub struct CardBuffer {
 
 #[no_mangle]
 pub extern "C" fn rs_PokerCards_get_cards(p_pcs: *mut PokerCards) -> CardBuffer {
+    let t0 = stats::begin();
     // 取结构
     let ps = unsafe { Box::from_raw(p_pcs) };
     let buf = ps.cards.clone().into_boxed_slice();
@@ -180,9 +415,93 @@ pub extern "C" fn rs_PokerCards_get_cards(p_pcs: *mut PokerCards) -> CardBuffer
     let data: *mut PokerCard = Box::into_raw(buf) as _;
     // std::mem::forget(data);
     std::mem::forget(ps);
+    stats::record(
+        StatEp::PokerGetCards,
+        t0,
+        (len * std::mem::size_of::<PokerCard>()) as u64,
+    );
     CardBuffer { data, len }
 }
 
+// rs_PokerCards_get_cards的arena版本
+// 结果写入arena内存,禁止对返回值调rs_CardBuffer_free
+// arena耗尽时返回data=null/len=0
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_get_cards_arena(
+    p_pcs: *mut PokerCards,
+    p_arena: *mut arena::Arena,
+) -> CardBuffer {
+    let empty = CardBuffer {
+        data: std::ptr::null_mut(),
+        len: 0,
+    };
+    if p_pcs.is_null() || p_arena.is_null() {
+        return empty;
+    }
+    let ps = unsafe { &*p_pcs };
+    let ar = unsafe { &mut *p_arena };
+    let len = ps.cards.len();
+    let data: *mut PokerCard = ar.alloc_slice(len);
+    if data.is_null() {
+        return empty;
+    }
+    unsafe {
+        std::ptr::copy_nonoverlapping(ps.cards.as_ptr(), data, len);
+    }
+    CardBuffer { data, len }
+}
+
+// rs_PokerCards_get_cards的SoA版本
+// 花色和点数分别写入两个紧凑的u8数组,各cap容量
+// 字段连续存放,便于分析侧做向量化直方图统计
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_get_cards_soa(
+    p_pcs: *mut PokerCards,
+    p_suits: *mut u8,
+    p_numbers: *mut u8,
+    cap: usize,
+) -> i8 {
+    if p_pcs.is_null() || p_suits.is_null() || p_numbers.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &*p_pcs };
+    let len = ps.cards.len();
+    if len > cap {
+        return -1;
+    }
+    let suits = unsafe { std::slice::from_raw_parts_mut(p_suits, cap) };
+    let numbers = unsafe { std::slice::from_raw_parts_mut(p_numbers, cap) };
+    for (i, c) in ps.cards.iter().enumerate() {
+        let (t, n) = c.get_suit_num();
+        suits[i] = t;
+        numbers[i] = n;
+    }
+    return len as i8;
+}
+
+// rs_PokerCards_get_cards的无分配版本
+// 将牌写入调用方提供的p_out缓冲区(容量cap张)
+// 省去堆分配和rs_CardBuffer_free调用
+// 返回实际写入张数,容量不足或参数非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_get_cards_into(
+    p_pcs: *mut PokerCards,
+    p_out: *mut PokerCard,
+    cap: usize,
+) -> i8 {
+    if p_pcs.is_null() || p_out.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &*p_pcs };
+    let len = ps.cards.len();
+    if len > cap {
+        return -1;
+    }
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, cap) };
+    outs[..len].copy_from_slice(&ps.cards);
+    return len as i8;
+}
+
 #[no_mangle]
 pub extern "C" fn rs_CardBuffer_free(buf: CardBuffer) {
     let s = unsafe { std::slice::from_raw_parts_mut(buf.data, buf.len) };
@@ -197,7 +516,59 @@ pub extern "C" fn rs_PokerCards_get_counter(p_stu: *mut PokerCards, s: Suit) ->
     if p_stu.is_null() {
         return std::ptr::null::<Counter>() as *mut _;
     }
-    unsafe { &mut ((*p_stu)[s]) as *mut Counter }
+    unsafe { &mut ((&mut *p_stu)[s]) as *mut Counter }
+}
+
+// rs_Counter_new的arena版本:计数器快照分配在arena里
+// 禁止对返回值调rs_Counter_free,arena耗尽返回null
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_get_counter_arena(
+    p_stu: *mut PokerCards,
+    s: Suit,
+    p_arena: *mut arena::Arena,
+) -> *mut Counter {
+    if p_stu.is_null() || p_arena.is_null() {
+        return std::ptr::null_mut();
+    }
+    let ar = unsafe { &mut *p_arena };
+    let out: *mut Counter = ar.alloc_slice(1);
+    if out.is_null() {
+        return std::ptr::null_mut();
+    }
+    unsafe {
+        *out = (&*p_stu)[s];
+    }
+    out
+}
+
+// 计数器按值拷入调用方结构,无分配无所有权问题
+// 替代返回指针的rs_PokerCards_get_counter
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_read_counter(
+    p_stu: *mut PokerCards,
+    s: Suit,
+    p_out: *mut Counter,
+) -> i8 {
+    if p_stu.is_null() || p_out.is_null() {
+        return -1;
+    }
+    unsafe {
+        *p_out = (&*p_stu)[s];
+    }
+    return 0;
+}
+
+// 一次调用拷出全部5个花色计数器
+// p_out为5个Counter的数组,下标即Suit顺序
+#[no_mangle]
+pub extern "C" fn rs_PokerCards_read_counters(p_stu: *mut PokerCards, p_out: *mut Counter) -> i8 {
+    if p_stu.is_null() || p_out.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &*p_stu };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 5usize) };
+    outs.copy_from_slice(&ps.counters);
+    return 0;
 }
 
 #[no_mangle]
@@ -249,6 +620,16 @@ pub extern "C" fn rs_TexasCards_free(p_poker: *mut TexasCards) {
     }
 }
 
+// 恢复到刚构造完的状态,配合对象池复用对象,避免free/new开销
+#[no_mangle]
+pub extern "C" fn rs_TexasCards_reset(p_pcs: *mut TexasCards) -> i8 {
+    if p_pcs.is_null() {
+        return -1;
+    }
+    unsafe { &mut *p_pcs }.reset();
+    return 0;
+}
+
 #[no_mangle]
 pub extern "C" fn rs_TexasCards_assign(
     p_pcs: *mut TexasCards,
@@ -258,6 +639,7 @@ pub extern "C" fn rs_TexasCards_assign(
     if p_pcs.is_null() || p_data.is_null() || data_len == 0 {
         return -1;
     }
+    let t0 = stats::begin();
     let ret: i8;
     // 取结构
     let mut ps = unsafe { Box::from_raw(p_pcs) };
@@ -273,9 +655,27 @@ pub extern "C" fn rs_TexasCards_assign(
     }
     println!("{}", ps);
     std::mem::forget(ps);
+    stats::record(StatEp::TexasAssign, t0, 0);
     return ret;
 }
 
+// assign的无检查快速路径
+// 前置条件:5~7张已校验过且互不相同的牌码
+// 跳过长度/去重/范围检查和错误路径,也不打印调试信息
+#[no_mangle]
+pub extern "C" fn rs_TexasCards_assign_unchecked(
+    p_pcs: *mut TexasCards,
+    p_data: *const u16,
+    data_len: usize,
+) -> i8 {
+    if p_pcs.is_null() || p_data.is_null() || data_len == 0 {
+        return -1;
+    }
+    let ps = unsafe { &mut *p_pcs };
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    ps.assign_unchecked(slice) as i8
+}
+
 #[repr(C)]
 pub struct TexasCardBuffer {
     cardbuf: CardBuffer,
@@ -285,6 +685,7 @@ pub struct TexasCardBuffer {
 
 #[no_mangle]
 pub extern "C" fn rs_TexasCards_get_best(p_pcs: *mut TexasCards) -> TexasCardBuffer {
+    let t0 = stats::begin();
     // 取结构
     let ps = unsafe { Box::from_raw(p_pcs) };
     let buf = ps.best.clone().into_boxed_slice();
@@ -294,6 +695,11 @@ pub extern "C" fn rs_TexasCards_get_best(p_pcs: *mut TexasCards) -> TexasCardBuf
     let score = ps.score;
     // std::mem::forget(data);
     std::mem::forget(ps);
+    stats::record(
+        StatEp::TexasGetBest,
+        t0,
+        (len * std::mem::size_of::<PokerCard>()) as u64,
+    );
     TexasCardBuffer {
         cardbuf: CardBuffer { data, len },
         texas,
@@ -301,6 +707,445 @@ pub extern "C" fn rs_TexasCards_get_best(p_pcs: *mut TexasCards) -> TexasCardBuf
     }
 }
 
+// 每线程一个常驻的TexasCards,供一次性求值接口复用
+// 热身后内部vec容量稳定,不再产生堆分配
+thread_local! {
+    static TEXAS_SCRATCH: std::cell::RefCell<TexasCards> =
+        std::cell::RefCell::new(TexasCards::new());
+}
+
+// 分数里每张牌的6bit段在bit4~5带花色tiebreak((3-s)<<4)
+// 跨座位比大小时要把花色位清掉,只留牌型(bit30起)和点数
+pub(crate) const SCORE_RANK_MASK: u64 = 0xF3C_F3CF | (!0u64 << 30);
+
+pub(crate) fn rank_score(s: u64) -> u64 {
+    s & SCORE_RANK_MASK
+}
+
+// 无王牌手牌校验:长度5~7,牌码限四花色(紧凑1~52或百位形式)
+// 用一个u64 bitmask顺便去重,不分配不走错误字符串路径
+pub(crate) fn check_nojoker(cards: &[u16]) -> bool {
+    if cards.len() < 5 || cards.len() > 7 {
+        return false;
+    }
+    let mut mask = 0u64;
+    for v in cards {
+        let idx = if *v >= 1 && *v <= 52 {
+            (*v - 1) as u64
+        } else if *v >= 101 && *v <= 413 && *v % 100 >= 1 && *v % 100 <= 13 {
+            (*v / 100 - 1) as u64 * 13 + (*v % 100 - 1) as u64
+        } else {
+            return false;
+        };
+        if mask & (1u64 << idx) != 0 {
+            return false;
+        }
+        mask |= 1u64 << idx;
+    }
+    true
+}
+
+// 一次性求值接口
+// 不需要rs_TexasCards_new/free,一次调用直接得到牌型和分数
+// 适合Monte Carlo模拟等高频场景
+// 无王牌的手牌(现金局的全部手牌)自动走专用快速路径
+#[no_mangle]
+pub extern "C" fn rs_Texas_eval(
+    p_data: *const u16,
+    data_len: usize,
+    p_texas: *mut TexasType,
+    p_score: *mut u64,
+) -> i8 {
+    if p_data.is_null() || data_len == 0 || p_texas.is_null() || p_score.is_null() {
+        return -1;
+    }
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    if check_nojoker(slice) {
+        return rs_Texas_eval_nojoker(p_data, data_len, p_texas, p_score);
+    }
+    let t0 = stats::begin();
+    let ret = TEXAS_SCRATCH.with(|tc| {
+        let mut ps = tc.borrow_mut();
+        match ps.assign(slice) {
+            Ok(_) => {
+                unsafe {
+                    *p_texas = ps.texas;
+                    *p_score = ps.score;
+                }
+                0
+            }
+            Err(_) => -1,
+        }
+    });
+    stats::record(StatEp::TexasEval, t0, 0);
+    ret
+}
+
+// 无王牌专用求值路径
+// 校验走bitmask(无堆分配),求值走assign_unchecked的无分支解码
+// 手牌含王牌码或非法时返回-1,不回退到通用路径
+#[no_mangle]
+pub extern "C" fn rs_Texas_eval_nojoker(
+    p_data: *const u16,
+    data_len: usize,
+    p_texas: *mut TexasType,
+    p_score: *mut u64,
+) -> i8 {
+    if p_data.is_null() || data_len == 0 || p_texas.is_null() || p_score.is_null() {
+        return -1;
+    }
+    let t0 = stats::begin();
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    if !check_nojoker(slice) {
+        return -1;
+    }
+    // 置换表命中:一次hash探测出结果,牌型在分数第30位起
+    if let Some(score) = cache::probe(slice) {
+        unsafe {
+            *p_texas = std::mem::transmute((score >> 30) as u32);
+            *p_score = score;
+        }
+        stats::record(StatEp::TexasEval, t0, 0);
+        return 0;
+    }
+    TEXAS_SCRATCH.with(|tc| {
+        let mut ps = tc.borrow_mut();
+        ps.assign_unchecked(slice);
+        unsafe {
+            *p_texas = ps.texas;
+            *p_score = ps.score;
+        }
+        cache::insert(slice, ps.score);
+    });
+    stats::record(StatEp::TexasEval, t0, 0);
+    return 0;
+}
+
+// 5/6张状态的一次性抽牌分布
+// 枚举全部剩余牌,对每张候选牌求值落点牌型,结果按牌型计数
+// p_counts为11个u64(下标即rs_TexasType),一次调用代替客户端
+// 逐张mutate+assign+get_best的几十次FFI往返,循环全程复用scratch
+// 返回枚举的剩余牌张数,手牌含王牌或非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_Texas_draw_histogram(
+    p_data: *const u16,
+    data_len: usize,
+    p_counts: *mut u64,
+) -> i64 {
+    if p_data.is_null() || (data_len != 5 && data_len != 6) || p_counts.is_null() {
+        return -1;
+    }
+    let slice = unsafe { std::slice::from_raw_parts(p_data, data_len) };
+    if !check_nojoker(slice) {
+        return -1;
+    }
+    let counts = unsafe { std::slice::from_raw_parts_mut(p_counts, 11) };
+    counts.fill(0);
+    let mut used = [false; 53];
+    for v in slice {
+        // check_nojoker过了,这里只需归一成紧凑码
+        let c = if *v < 100 {
+            *v
+        } else {
+            (*v / 100 - 1) * 13 + *v % 100
+        };
+        used[c as usize] = true;
+    }
+    let mut hand = [0u16; 7];
+    hand[..data_len].copy_from_slice(slice);
+    let mut total = 0i64;
+    TEXAS_SCRATCH.with(|tc| {
+        let mut ps = tc.borrow_mut();
+        for c in 1u16..=52 {
+            if used[c as usize] {
+                continue;
+            }
+            hand[data_len] = c;
+            ps.assign_unchecked(&hand[..data_len + 1]);
+            counts[ps.texas as usize] += 1;
+            total += 1;
+        }
+    });
+    total
+}
+
+// rs_TexasCards_eval_batch的无王牌版本,无须new/free
+// 每手固定7张,整批都走bitmask校验+assign_unchecked
+// 非法手对应结果写no_calc和0,返回成功求值的手数
+#[no_mangle]
+pub extern "C" fn rs_Texas_eval_batch_nojoker(
+    p_hands: *const u16,
+    n_hands: usize,
+    p_types: *mut TexasType,
+    p_scores: *mut u64,
+) -> i64 {
+    if p_hands.is_null() || n_hands == 0 || p_types.is_null() || p_scores.is_null() {
+        return -1;
+    }
+    let t0 = stats::begin();
+    let hands = unsafe { std::slice::from_raw_parts(p_hands, n_hands * 7) };
+    let types = unsafe { std::slice::from_raw_parts_mut(p_types, n_hands) };
+    let scores = unsafe { std::slice::from_raw_parts_mut(p_scores, n_hands) };
+    let mut ok = 0i64;
+    TEXAS_SCRATCH.with(|tc| {
+        let mut ps = tc.borrow_mut();
+        for i in 0..n_hands {
+            let h = &hands[i * 7..i * 7 + 7];
+            if check_nojoker(h) {
+                if let Some(score) = cache::probe(h) {
+                    types[i] = unsafe { std::mem::transmute((score >> 30) as u32) };
+                    scores[i] = score;
+                } else {
+                    ps.assign_unchecked(h);
+                    types[i] = ps.texas;
+                    scores[i] = ps.score;
+                    cache::insert(h, ps.score);
+                }
+                ok += 1;
+            } else {
+                types[i] = TexasType::NoCalc;
+                scores[i] = 0;
+            }
+        }
+    });
+    stats::record(StatEp::TexasEvalBatch, t0, 0);
+    return ok;
+}
+
+// 一桌摊牌
+// p_board为5张公共牌,p_holes为n_players*2张底牌(逐座位排列)
+// 每个座位的牌型/分数/名次写入调用方数组,名次0为最大,并列同名次
+// 返回赢家bitmask(bit i代表座位i,并列全部置位),参数或手牌非法返回-1
+// 比较全部在库内完成,一次调用结算整桌
+#[no_mangle]
+pub extern "C" fn rs_Texas_showdown(
+    p_board: *const u16,
+    p_holes: *const u16,
+    n_players: usize,
+    p_types: *mut TexasType,
+    p_scores: *mut u64,
+    p_ranks: *mut u8,
+) -> i64 {
+    if p_board.is_null()
+        || p_holes.is_null()
+        || n_players < 2
+        || n_players > 32
+        || p_types.is_null()
+        || p_scores.is_null()
+        || p_ranks.is_null()
+    {
+        return -1;
+    }
+    let board = unsafe { std::slice::from_raw_parts(p_board, 5) };
+    let holes = unsafe { std::slice::from_raw_parts(p_holes, n_players * 2) };
+    // 公共牌+全部底牌联合查重:同一张牌出现在两处是非法输入
+    let mut used = [false; 53];
+    for v in board.iter().chain(holes.iter()) {
+        let c = if *v < 100 {
+            *v
+        } else if *v % 100 >= 1 && *v % 100 <= 13 && *v / 100 >= 1 && *v / 100 <= 4 {
+            (*v / 100 - 1) * 13 + *v % 100
+        } else {
+            return -1;
+        };
+        if c < 1 || c > 52 || used[c as usize] {
+            return -1;
+        }
+        used[c as usize] = true;
+    }
+    let types = unsafe { std::slice::from_raw_parts_mut(p_types, n_players) };
+    let scores = unsafe { std::slice::from_raw_parts_mut(p_scores, n_players) };
+    let ranks = unsafe { std::slice::from_raw_parts_mut(p_ranks, n_players) };
+    let mut hand = [0u16; 7];
+    hand[..5].copy_from_slice(board);
+    let ok = TEXAS_SCRATCH.with(|tc| {
+        let mut ps = tc.borrow_mut();
+        for i in 0..n_players {
+            hand[5] = holes[i * 2];
+            hand[6] = holes[i * 2 + 1];
+            match ps.assign(&hand) {
+                Ok(_) => {
+                    types[i] = ps.texas;
+                    scores[i] = ps.score;
+                }
+                Err(_) => return false,
+            }
+        }
+        true
+    });
+    if !ok {
+        return -1;
+    }
+    // 名次为分数比自己大的座位数,并列自然同名次
+    // 比较前清掉花色tiebreak位,点数相同的手牌按平局结算
+    let best = scores.iter().map(|s| rank_score(*s)).max().unwrap();
+    let mut mask = 0i64;
+    for i in 0..n_players {
+        let si = rank_score(scores[i]);
+        ranks[i] = scores.iter().filter(|s| rank_score(**s) > si).count() as u8;
+        if si == best {
+            mask |= 1 << i;
+        }
+    }
+    return mask;
+}
+
+// numpy缓冲区友好的批量求值,给Python分析管线用
+// p_hands为n_hands手牌的扁平数组,每手占stride个u16,取前hand_len个牌码
+// 分数写入p_scores(u64),牌型写入p_types(u8),都由调用方预分配
+// 非法手对应位置写0,返回成功求值的手数,参数非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_Texas_eval_array(
+    p_hands: *const u16,
+    n_hands: usize,
+    stride: usize,
+    hand_len: usize,
+    p_scores: *mut u64,
+    p_types: *mut u8,
+) -> i64 {
+    if p_hands.is_null()
+        || n_hands == 0
+        || hand_len == 0
+        || stride < hand_len
+        || p_scores.is_null()
+        || p_types.is_null()
+    {
+        return -1;
+    }
+    let hands = unsafe { std::slice::from_raw_parts(p_hands, n_hands * stride) };
+    let scores = unsafe { std::slice::from_raw_parts_mut(p_scores, n_hands) };
+    let types = unsafe { std::slice::from_raw_parts_mut(p_types, n_hands) };
+    let mut ok = 0i64;
+    TEXAS_SCRATCH.with(|tc| {
+        let mut ps = tc.borrow_mut();
+        for i in 0..n_hands {
+            let h = &hands[i * stride..i * stride + hand_len];
+            match ps.assign(h) {
+                Ok(_) => {
+                    scores[i] = ps.score;
+                    types[i] = ps.texas as u8;
+                    ok += 1;
+                }
+                Err(_) => {
+                    scores[i] = 0;
+                    types[i] = TexasType::NoCalc as u8;
+                }
+            }
+        }
+    });
+    return ok;
+}
+
+// rs_TexasCards_get_best的arena版本
+// 最佳5张写入arena,禁止对返回值调rs_TexasCardBuffer_free
+// arena耗尽时返回data=null/len=0
+#[no_mangle]
+pub extern "C" fn rs_TexasCards_get_best_arena(
+    p_pcs: *mut TexasCards,
+    p_arena: *mut arena::Arena,
+) -> TexasCardBuffer {
+    let empty = TexasCardBuffer {
+        cardbuf: CardBuffer {
+            data: std::ptr::null_mut(),
+            len: 0,
+        },
+        texas: TexasType::NoCalc,
+        score: 0,
+    };
+    if p_pcs.is_null() || p_arena.is_null() {
+        return empty;
+    }
+    let ps = unsafe { &*p_pcs };
+    let ar = unsafe { &mut *p_arena };
+    let len = ps.best.len();
+    let data: *mut PokerCard = ar.alloc_slice(len);
+    if data.is_null() {
+        return empty;
+    }
+    unsafe {
+        std::ptr::copy_nonoverlapping(ps.best.as_ptr(), data, len);
+    }
+    TexasCardBuffer {
+        cardbuf: CardBuffer { data, len },
+        texas: ps.texas,
+        score: ps.score,
+    }
+}
+
+// rs_TexasCards_get_best的无分配版本
+// 最佳5张写入调用方提供的p_out缓冲区(容量cap张)
+// 牌型和分数写入p_texas和p_score
+// 返回实际写入张数,容量不足或参数非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_TexasCards_get_best_into(
+    p_pcs: *mut TexasCards,
+    p_out: *mut PokerCard,
+    cap: usize,
+    p_texas: *mut TexasType,
+    p_score: *mut u64,
+) -> i8 {
+    if p_pcs.is_null() || p_out.is_null() || p_texas.is_null() || p_score.is_null() {
+        return -1;
+    }
+    let ps = unsafe { &*p_pcs };
+    let len = ps.best.len();
+    if len > cap {
+        return -1;
+    }
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, cap) };
+    outs[..len].copy_from_slice(&ps.best);
+    unsafe {
+        *p_texas = ps.texas;
+        *p_score = ps.score;
+    }
+    return len as i8;
+}
+
+// 批量计算牌型
+// 一次调用处理n_hands手牌(每手固定7张,p_hands长度为n_hands*7)
+// 内部循环复用同一个TexasCards,摊薄FFI调用开销
+// 牌型写入p_types,分数写入p_scores,两者都由调用方提供,长度为n_hands
+// 某手牌非法时对应结果写入no_calc和0,不中断整批计算
+#[no_mangle]
+pub extern "C" fn rs_TexasCards_eval_batch(
+    p_pcs: *mut TexasCards,
+    p_hands: *const u16,
+    n_hands: usize,
+    p_types: *mut TexasType,
+    p_scores: *mut u64,
+) -> i8 {
+    if p_pcs.is_null()
+        || p_hands.is_null()
+        || n_hands == 0
+        || p_types.is_null()
+        || p_scores.is_null()
+    {
+        return -1;
+    }
+    let t0 = stats::begin();
+    // 取结构
+    let mut ps = unsafe { Box::from_raw(p_pcs) };
+    // 取数据
+    let hands = unsafe { std::slice::from_raw_parts(p_hands, n_hands * 7) };
+    let types = unsafe { std::slice::from_raw_parts_mut(p_types, n_hands) };
+    let scores = unsafe { std::slice::from_raw_parts_mut(p_scores, n_hands) };
+    for i in 0..n_hands {
+        match ps.assign(&hands[i * 7..i * 7 + 7]) {
+            Ok(_) => {
+                types[i] = ps.texas;
+                scores[i] = ps.score;
+            }
+            Err(_) => {
+                types[i] = TexasType::NoCalc;
+                scores[i] = 0;
+            }
+        }
+    }
+    std::mem::forget(ps);
+    stats::record(StatEp::TexasEvalBatch, t0, 0);
+    return 0;
+}
+
 #[no_mangle]
 pub extern "C" fn rs_TexasCardBuffer_free(buf: TexasCardBuffer) {
     let s = unsafe { std::slice::from_raw_parts_mut(buf.cardbuf.data, buf.cardbuf.len) };
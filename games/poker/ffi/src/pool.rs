@@ -0,0 +1,103 @@
+// 对象池
+// 启动时一次性预构造N个对象,热路径上acquire/release不再经过malloc/free
+// 配合rs_*_reset可以让一个对象在worker线程里无限期复用
+use gin_rummy_lib::cards::GinRummyCards;
+use poker_lib::PokerCards;
+use texas_lib::TexasCards;
+
+// 池内用Box持有空闲对象,acquire转移所有权给调用方
+// release收回所有权并reset,供下次acquire复用
+struct Pool<T> {
+    free: Vec<Box<T>>,
+}
+
+impl<T> Pool<T> {
+    fn new(n: usize, ctor: fn() -> T) -> Self {
+        let mut free = Vec::with_capacity(n);
+        for _ in 0..n {
+            free.push(Box::new(ctor()));
+        }
+        Self { free }
+    }
+
+    fn acquire(&mut self) -> *mut T {
+        match self.free.pop() {
+            Some(b) => Box::into_raw(b),
+            None => std::ptr::null_mut(),
+        }
+    }
+
+    fn release(&mut self, p: *mut T) {
+        self.free.push(unsafe { Box::from_raw(p) });
+    }
+}
+
+// 三个宏展开同一套池接口:new/free/acquire/release
+// 池耗尽时acquire返回null,调用方可回退到rs_*_new
+macro_rules! pool_ffi {
+    ($pool:ident, $obj:ty, $ctor:expr,
+     $fn_new:ident, $fn_free:ident, $fn_acquire:ident, $fn_release:ident) => {
+        pub struct $pool(Pool<$obj>);
+
+        #[no_mangle]
+        pub extern "C" fn $fn_new(n: usize) -> *mut $pool {
+            Box::into_raw(Box::new($pool(Pool::new(n, $ctor))))
+        }
+
+        #[no_mangle]
+        pub extern "C" fn $fn_free(p_pool: *mut $pool) {
+            if !p_pool.is_null() {
+                unsafe {
+                    let _ = Box::from_raw(p_pool);
+                };
+            }
+        }
+
+        #[no_mangle]
+        pub extern "C" fn $fn_acquire(p_pool: *mut $pool) -> *mut $obj {
+            if p_pool.is_null() {
+                return std::ptr::null_mut();
+            }
+            unsafe { (&mut *p_pool).0.acquire() }
+        }
+
+        #[no_mangle]
+        pub extern "C" fn $fn_release(p_pool: *mut $pool, p_obj: *mut $obj) {
+            if p_pool.is_null() || p_obj.is_null() {
+                return;
+            }
+            unsafe { &mut *p_obj }.reset();
+            unsafe { (&mut *p_pool).0.release(p_obj) };
+        }
+    };
+}
+
+pool_ffi!(
+    PokerCardsPool,
+    PokerCards,
+    PokerCards::new,
+    rs_PokerCardsPool_new,
+    rs_PokerCardsPool_free,
+    rs_PokerCardsPool_acquire,
+    rs_PokerCardsPool_release
+);
+
+pool_ffi!(
+    TexasCardsPool,
+    TexasCards,
+    TexasCards::new,
+    rs_TexasCardsPool_new,
+    rs_TexasCardsPool_free,
+    rs_TexasCardsPool_acquire,
+    rs_TexasCardsPool_release
+);
+
+pool_ffi!(
+    GinRummyCardsPool,
+    GinRummyCards,
+    GinRummyCards::new,
+    rs_GinRummyCardsPool_new,
+    rs_GinRummyCardsPool_free,
+    rs_GinRummyCardsPool_acquire,
+    rs_GinRummyCardsPool_release
+);
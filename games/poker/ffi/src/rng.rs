@@ -0,0 +1,163 @@
+// 确定性发牌随机数发生器
+// 与test/trand.c里的MS LCG完全一致: s = (s*214013+2531011) & 0x7FFFFFFF
+// 同一个seed在任何平台得到相同的牌序,可以bit级复现对局
+// jump按仿射映射快速幂前进,工作线程无需通信即可瓜分一个种子序列
+use texas_lib::TexasCards;
+
+const LCG_A: u64 = 214013;
+const LCG_C: u64 = 2531011;
+const LCG_M: u64 = 0x8000_0000;
+
+pub struct DealRng {
+    state: u64,
+}
+
+impl DealRng {
+    pub fn new(seed: u64) -> Self {
+        Self {
+            state: seed & (LCG_M - 1),
+        }
+    }
+
+    // 一次draw对应trand.c里的一次取数,输出高15位
+    pub fn draw(&mut self) -> u32 {
+        self.state = (self.state * LCG_A + LCG_C) % LCG_M;
+        ((self.state >> 16) & 0x7FFF) as u32
+    }
+
+    // 前进n次draw,O(log n)
+    // 仿射映射复合: f(f(x)) = a^2*x + (a*c + c)
+    pub fn jump(&mut self, mut n: u64) {
+        let mut a = LCG_A;
+        let mut c = LCG_C;
+        let mut ja: u64 = 1;
+        let mut jc: u64 = 0;
+        while n > 0 {
+            if n & 1 == 1 {
+                ja = (ja * a) % LCG_M;
+                jc = (jc * a + c) % LCG_M;
+            }
+            c = (a * c + c) % LCG_M;
+            a = (a * a) % LCG_M;
+            n >>= 1;
+        }
+        self.state = (ja * self.state + jc) % LCG_M;
+    }
+
+    // Fisher-Yates洗一副52张牌(紧凑编码1~52),消耗51次draw
+    pub fn fill_deck(&mut self, deck: &mut [u16]) {
+        for (i, d) in deck.iter_mut().enumerate().take(52) {
+            *d = (i + 1) as u16;
+        }
+        for i in (1..52usize).rev() {
+            let j = self.draw() as usize % (i + 1);
+            deck.swap(i, j);
+        }
+    }
+}
+
+// 从种子构造发牌RNG
+#[no_mangle]
+pub extern "C" fn rs_DealRng_new(seed: u64) -> *mut DealRng {
+    Box::into_raw(Box::new(DealRng::new(seed)))
+}
+
+#[no_mangle]
+pub extern "C" fn rs_DealRng_free(p_rng: *mut DealRng) {
+    if !p_rng.is_null() {
+        unsafe {
+            let _ = Box::from_raw(p_rng);
+        }
+    }
+}
+
+// 取下一个15位随机数,与trand.c输出一致
+#[no_mangle]
+pub extern "C" fn rs_DealRng_next(p_rng: *mut DealRng) -> u32 {
+    if p_rng.is_null() {
+        return 0;
+    }
+    unsafe { &mut *p_rng }.draw()
+}
+
+// 前进n_draws次取数,一副牌消耗51次
+#[no_mangle]
+pub extern "C" fn rs_DealRng_jump(p_rng: *mut DealRng, n_draws: u64) -> i8 {
+    if p_rng.is_null() {
+        return -1;
+    }
+    unsafe { &mut *p_rng }.jump(n_draws);
+    return 0;
+}
+
+// 向调用方缓冲区写入一副洗好的52张牌,cap不足返回-1
+#[no_mangle]
+pub extern "C" fn rs_DealRng_deck(p_rng: *mut DealRng, p_out: *mut u16, cap: usize) -> i8 {
+    if p_rng.is_null() || p_out.is_null() || cap < 52 {
+        return -1;
+    }
+    let rng = unsafe { &mut *p_rng };
+    let out = unsafe { std::slice::from_raw_parts_mut(p_out, 52) };
+    rng.fill_deck(out);
+    return 0;
+}
+
+// 单线程扫一段种子区间,收集牌型达标的种子
+// 每个种子独立洗一副牌,判定前n_cards张的德州牌型
+fn search_range(seed_lo: u64, seed_hi: u64, n_cards: usize, min_type: u8) -> Vec<u64> {
+    let mut deck = [0u16; 52];
+    let mut ps = TexasCards::new();
+    let mut hits = vec![];
+    for seed in seed_lo..seed_hi {
+        let mut rng = DealRng::new(seed);
+        rng.fill_deck(&mut deck);
+        ps.assign_unchecked(&deck[..n_cards]);
+        if ps.texas as u8 >= min_type {
+            hits.push(seed);
+        }
+    }
+    hits
+}
+
+// 在[seed_lo, seed_hi)区间批量生成牌局并筛选种子
+// 谓词:每个种子洗出的前n_cards张(5~7)构成的德州牌型 >= min_type
+// 命中种子升序写入p_seeds(最多cap个),返回命中总数(可能大于cap)
+// 区间按n_threads个线程切块并行,参数非法返回-1
+#[no_mangle]
+pub extern "C" fn rs_DealRng_search(
+    seed_lo: u64,
+    seed_hi: u64,
+    n_cards: usize,
+    min_type: u8,
+    n_threads: usize,
+    p_seeds: *mut u64,
+    cap: usize,
+) -> i64 {
+    if seed_lo >= seed_hi || n_cards < 5 || n_cards > 7 || min_type > 10 || p_seeds.is_null() {
+        return -1;
+    }
+    let nt = if n_threads == 0 { 1 } else { n_threads.min(64) };
+    let total = seed_hi - seed_lo;
+    let chunk = total / nt as u64 + if total % nt as u64 > 0 { 1 } else { 0 };
+    let mut hits = vec![];
+    std::thread::scope(|s| {
+        let mut handles = vec![];
+        for t in 0..nt as u64 {
+            let lo = seed_lo + t * chunk;
+            let hi = (lo + chunk).min(seed_hi);
+            if lo >= hi {
+                break;
+            }
+            handles.push(s.spawn(move || search_range(lo, hi, n_cards, min_type)));
+        }
+        // 线程按区间顺序join,合并结果天然升序
+        for h in handles {
+            hits.extend(h.join().unwrap());
+        }
+    });
+    let n = hits.len().min(cap);
+    unsafe {
+        std::ptr::copy_nonoverlapping(hits.as_ptr(), p_seeds, n);
+    }
+    hits.len() as i64
+}
@@ -0,0 +1,112 @@
+// 生产剖析用的轻量计数器
+// 默认关闭,关闭时每个入口只多一次relaxed原子读
+// 打开后按入口点累计调用次数/耗时ns/结果缓冲分配字节数
+// 全部relaxed原子,可以在生产环境长期开启
+use std::sync::atomic::{AtomicBool, AtomicU64, Ordering::Relaxed};
+use std::time::Instant;
+
+// 被统计的入口点,下标即rs_Stats_read的ep参数
+#[repr(u8)]
+#[derive(Clone, Copy)]
+pub enum StatEp {
+    PokerAssign = 0,
+    PokerGetCards = 1,
+    TexasAssign = 2,
+    TexasGetBest = 3,
+    TexasEval = 4,
+    TexasEvalBatch = 5,
+    GinAssign = 6,
+    GinUpdate = 7,
+}
+
+pub(crate) const EP_COUNT: usize = 8;
+
+// 单个入口点的统计快照
+#[repr(C)]
+pub struct FfiStat {
+    pub calls: u64,
+    pub ns: u64,
+    pub alloc_bytes: u64,
+}
+
+struct EpCounters {
+    calls: AtomicU64,
+    ns: AtomicU64,
+    alloc_bytes: AtomicU64,
+}
+
+#[allow(clippy::declare_interior_mutable_const)]
+const ZERO: EpCounters = EpCounters {
+    calls: AtomicU64::new(0),
+    ns: AtomicU64::new(0),
+    alloc_bytes: AtomicU64::new(0),
+};
+
+static ENABLED: AtomicBool = AtomicBool::new(false);
+static COUNTERS: [EpCounters; EP_COUNT] = [ZERO; EP_COUNT];
+
+// 入口处调用:未开启时返回None,几乎零开销
+pub(crate) fn begin() -> Option<Instant> {
+    if ENABLED.load(Relaxed) {
+        Some(Instant::now())
+    } else {
+        None
+    }
+}
+
+// 出口处调用:bytes为本次调用分配的结果缓冲字节数
+pub(crate) fn record(ep: StatEp, t0: Option<Instant>, bytes: u64) {
+    if let Some(t) = t0 {
+        let c = &COUNTERS[ep as usize];
+        c.calls.fetch_add(1, Relaxed);
+        c.ns.fetch_add(t.elapsed().as_nanos() as u64, Relaxed);
+        if bytes > 0 {
+            c.alloc_bytes.fetch_add(bytes, Relaxed);
+        }
+    }
+}
+
+// 开关统计,返回之前的状态
+#[no_mangle]
+pub extern "C" fn rs_Stats_enable(on: u8) -> i8 {
+    ENABLED.swap(on != 0, Relaxed) as i8
+}
+
+// 清零全部计数器
+#[no_mangle]
+pub extern "C" fn rs_Stats_reset() {
+    for c in &COUNTERS {
+        c.calls.store(0, Relaxed);
+        c.ns.store(0, Relaxed);
+        c.alloc_bytes.store(0, Relaxed);
+    }
+}
+
+// 读取单个入口点的快照
+#[no_mangle]
+pub extern "C" fn rs_Stats_read(ep: StatEp, p_out: *mut FfiStat) -> i8 {
+    if p_out.is_null() {
+        return -1;
+    }
+    let c = &COUNTERS[ep as usize];
+    unsafe {
+        (*p_out).calls = c.calls.load(Relaxed);
+        (*p_out).ns = c.ns.load(Relaxed);
+        (*p_out).alloc_bytes = c.alloc_bytes.load(Relaxed);
+    }
+    return 0;
+}
+
+// 一次读取全部入口点,p_out为8个rs_FfiStat的数组
+#[no_mangle]
+pub extern "C" fn rs_Stats_read_all(p_out: *mut FfiStat) -> i8 {
+    if p_out.is_null() {
+        return -1;
+    }
+    for i in 0..EP_COUNT {
+        unsafe {
+            rs_Stats_read(std::mem::transmute(i as u8), p_out.add(i));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+// 求值查找表的生成与加载
+// 表以二进制工件形式随库分发:rs_Texas_write_table生成文件
+// rs_Texas_load_table在启动时加载,加载失败或未加载时
+// 求值自动回退到原枚举路径,所有get_best/批量/一次性入口都生效
+use std::ffi::CStr;
+use std::io::Write;
+use std::os::raw::c_char;
+use texas_lib::{build_seq_table, load_seq_table, seq_table_loaded, SEQ_TABLE_SIZE};
+
+// 文件头16字节:magic + 版本 + payload长度
+const TABLE_MAGIC: &[u8; 4] = b"TXSQ";
+const TABLE_VERSION: u32 = 1;
+pub(crate) const TABLE_HEADER_SIZE: usize = 16;
+
+pub(crate) fn table_header(payload_len: usize) -> [u8; TABLE_HEADER_SIZE] {
+    let mut h = [0u8; TABLE_HEADER_SIZE];
+    h[..4].copy_from_slice(TABLE_MAGIC);
+    h[4..8].copy_from_slice(&TABLE_VERSION.to_le_bytes());
+    h[8..16].copy_from_slice(&(payload_len as u64).to_le_bytes());
+    h
+}
+
+pub(crate) fn check_table_header(h: &[u8]) -> bool {
+    h.len() >= TABLE_HEADER_SIZE
+        && &h[..4] == TABLE_MAGIC
+        && u32::from_le_bytes(h[4..8].try_into().unwrap()) == TABLE_VERSION
+        && u64::from_le_bytes(h[8..16].try_into().unwrap()) as usize == SEQ_TABLE_SIZE
+}
+
+fn path_from_c(p_path: *const c_char) -> Option<&'static str> {
+    if p_path.is_null() {
+        return None;
+    }
+    unsafe { CStr::from_ptr(p_path) }.to_str().ok()
+}
+
+// 生成查找表并写出为二进制工件,成功返回0
+#[no_mangle]
+pub extern "C" fn rs_Texas_write_table(p_path: *const c_char) -> i8 {
+    let path = match path_from_c(p_path) {
+        Some(p) => p,
+        None => return -1,
+    };
+    let table = build_seq_table();
+    let mut f = match std::fs::File::create(path) {
+        Ok(f) => f,
+        Err(_) => return -1,
+    };
+    if f.write_all(&table_header(table.len())).is_err() || f.write_all(&table).is_err() {
+        return -1;
+    }
+    return 0;
+}
+
+// 启动时加载查找表,成功返回0
+// 文件缺失/损坏返回-1,求值继续走枚举路径,不影响正确性
+// 只读mmap直接映射文件:不解析不拷贝,启动即一次mmap
+// 同机多进程共享同一份物理页,32个server进程也只占一份内存
+#[no_mangle]
+pub extern "C" fn rs_Texas_load_table(p_path: *const c_char) -> i8 {
+    let path = match path_from_c(p_path) {
+        Some(p) => p,
+        None => return -1,
+    };
+    let f = match std::fs::File::open(path) {
+        Ok(f) => f,
+        Err(_) => return -1,
+    };
+    let mmap = match unsafe { memmap2::Mmap::map(&f) } {
+        Ok(m) => m,
+        Err(_) => return -1,
+    };
+    if !check_table_header(&mmap) || mmap.len() != TABLE_HEADER_SIZE + SEQ_TABLE_SIZE {
+        return -1;
+    }
+    // 映射常驻进程生命周期,forget换取'static
+    let data: &'static [u8] =
+        unsafe { std::slice::from_raw_parts(mmap.as_ptr(), mmap.len()) };
+    std::mem::forget(mmap);
+    if load_seq_table(&data[TABLE_HEADER_SIZE..]) {
+        0
+    } else {
+        -1
+    }
+}
+
+// 查表路径是否已生效
+#[no_mangle]
+pub extern "C" fn rs_Texas_table_loaded() -> i8 {
+    seq_table_loaded() as i8
+}
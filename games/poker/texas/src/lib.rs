@@ -5,8 +5,51 @@ use itertools::Itertools;
 use poker_lib::{sn2poker, PokerCard};
 use std::collections::HashSet;
 use std::fmt::{self, Display, Formatter};
+use std::sync::OnceLock;
 use TexasType::*;
 
+// 顺子查找表
+// 以13位点数bitmask为索引(bit0=2 ... bit11=K, bit12=A)
+// 值为能组成的最大顺子顶张点数,0表示无顺子
+// 生成为二进制工件后启动时加载,未加载时find_max_seq走原枚举路径
+pub const SEQ_TABLE_SIZE: usize = 1 << 13;
+
+static SEQ_TABLE: OnceLock<&'static [u8]> = OnceLock::new();
+
+// 枚举全部8192个bitmask,预计算顺子顶张
+pub fn build_seq_table() -> Vec<u8> {
+    let mut t = vec![0u8; SEQ_TABLE_SIZE];
+    for mask in 0..SEQ_TABLE_SIZE {
+        let mut top = 0u8;
+        // A2345: A(bit12)加2~5(bit0~3)
+        if mask & 0x100f == 0x100f {
+            top = 5;
+        }
+        // 顶张为n的顺子需要n-4~n连续5个点数
+        for n in 6..=14u8 {
+            let m = 0b11111usize << (n - 6) as usize;
+            if mask & m == m {
+                top = n;
+            }
+        }
+        t[mask] = top;
+    }
+    t
+}
+
+// 安装查找表,长度不符或重复安装返回false
+// 表数据需要'static生命周期(加载方leak或mmap保持)
+pub fn load_seq_table(data: &'static [u8]) -> bool {
+    if data.len() != SEQ_TABLE_SIZE {
+        return false;
+    }
+    SEQ_TABLE.set(data).is_ok()
+}
+
+pub fn seq_table_loaded() -> bool {
+    SEQ_TABLE.get().is_some()
+}
+
 #[repr(C)]
 #[derive(Debug, Clone, Copy, PartialEq)]
 pub enum TexasType {
@@ -65,7 +108,7 @@ impl TexasCards {
         }
     }
 
-    fn reset(&mut self) {
+    pub fn reset(&mut self) {
         self.cards.clear();
         for i in 0..4 {
             self.count_suit[i].clear();
@@ -96,13 +139,35 @@ impl TexasCards {
             } else {
                 PokerCard::from_u16(cards[i])?
             };
-            let (t, n) = c.get_suit_num();
-            let cn = if n == 1 { 14 } else { n };
-            //counter中1被转成了14
-            self.count_suit[t as usize].push(cn);
-            self.count_num[cn as usize].push(t);
-            self.cards.push(c);
+            self.push_card(c);
+        }
+        self.finish_assign();
+        // info!("{}", self);
+        Ok(self.cards.len() as u8)
+    }
+
+    //assign的无检查版本,调用方保证牌码合法且互不相同
+    //跳过长度/去重/范围检查和错误路径
+    pub fn assign_unchecked(&mut self, cards: &[u16]) -> u8 {
+        self.reset();
+        for v in cards {
+            self.push_card(PokerCard::from_code_unchecked(*v));
         }
+        self.finish_assign();
+        self.cards.len() as u8
+    }
+
+    fn push_card(&mut self, c: PokerCard) {
+        let (t, n) = c.get_suit_num();
+        let cn = if n == 1 { 14 } else { n };
+        //counter中1被转成了14
+        self.count_suit[t as usize].push(cn);
+        self.count_num[cn as usize].push(t);
+        self.cards.push(c);
+    }
+
+    //统计完成后排序并计算牌型分数,assign和assign_unchecked共用
+    fn finish_assign(&mut self) {
         for i in 0..4 {
             self.count_suit[i].sort();
             self.count_suit[i].reverse();
@@ -120,14 +185,19 @@ impl TexasCards {
         //计算牌型和分数
         self.calc_best();
         self.calc_score();
-
-        // info!("{}", self);
-        Ok(self.cards.len() as u8)
     }
 
     //返回0表示无顺子,14表示TJQKA,5表示A2345
     //其他返回顺子最大牌点
     fn find_max_seq(&self, nums: &[u8]) -> u8 {
+        //查表快速路径:点数合成bitmask,一次内存访问出结果
+        if let Some(t) = SEQ_TABLE.get() {
+            let mut mask = 0usize;
+            for n in nums {
+                mask |= 1 << (n - 2);
+            }
+            return t[mask];
+        }
         //去重排序
         //注意送进来的同花色和全局两种情况都已经去重了
         //这里的unique可以省略
@@ -16,4 +16,8 @@ int8_t rs_TemplateData_shuffle(rs_TemplateData *p_pcs);
 
 int8_t rs_TemplateData_next(rs_TemplateData *p_pcs, uint8_t *p_out);
 
+int64_t rs_TemplateData_next_n(rs_TemplateData *p_pcs, uint8_t *p_out, uintptr_t n);
+
+int64_t rs_TemplateData_shuffle_drain(rs_TemplateData *p_pcs, uint8_t *p_out, uintptr_t cap);
+
 } // extern "C"
@@ -7,6 +7,14 @@ void test_template() {
     rs_TemplateData_shuffle(td);
     rs_TemplateData_next(td, out);
     printf("out...%d\n", out[0]);
+
+    // batch draw, one call instead of 52
+    unsigned char deck[52];
+    long long n = rs_TemplateData_shuffle_drain(td, deck, 52);
+    printf("shuffle_drain...%lld %d %d %d\n", n, deck[0], deck[1], deck[2]);
+    rs_TemplateData_shuffle(td);
+    n = rs_TemplateData_next_n(td, deck, 10);
+    printf("next_n...%lld %d %d\n", n, deck[0], deck[9]);
     rs_TemplateData_free(td);
 }
 
@@ -41,3 +41,37 @@ pub extern "C" fn rs_TemplateData_next(p_pcs: *mut TemplateData, p_out: *mut u8)
     std::mem::forget(ps);
     return 0;
 }
+
+// batch draw: fill n items into the caller buffer in one FFI call
+// hot loops should use this instead of n rs_TemplateData_next calls
+#[no_mangle]
+pub extern "C" fn rs_TemplateData_next_n(p_pcs: *mut TemplateData, p_out: *mut u8, n: usize) -> i64 {
+    if p_pcs.is_null() || p_out.is_null() || n == 0 {
+        return -1;
+    }
+
+    let mut ps = unsafe { Box::from_raw(p_pcs) };
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, n) };
+    ps.next_n(outs);
+    std::mem::forget(ps);
+    return n as i64;
+}
+
+// shuffle and drain the whole pool in one call, cap must be >= 52
+#[no_mangle]
+pub extern "C" fn rs_TemplateData_shuffle_drain(
+    p_pcs: *mut TemplateData,
+    p_out: *mut u8,
+    cap: usize,
+) -> i64 {
+    if p_pcs.is_null() || p_out.is_null() || cap < 52 {
+        return -1;
+    }
+
+    let mut ps = unsafe { Box::from_raw(p_pcs) };
+    ps.shuffle();
+    let outs = unsafe { std::slice::from_raw_parts_mut(p_out, 52) };
+    ps.next_n(outs);
+    std::mem::forget(ps);
+    return 52;
+}
@@ -41,6 +41,13 @@ impl TemplateData {
         }
         ret
     }
+
+    // batch version of next, fills out in one pass
+    pub fn next_n(&mut self, out: &mut [u8]) {
+        for v in out.iter_mut() {
+            *v = self.next();
+        }
+    }
 }
 
 #[cfg(test)]